@@ -0,0 +1,66 @@
+// Compilación e instanciación del módulo WebAssembly, compartidas por el hilo
+// principal (src/wasmLoader.ts) y el worker de render (public/tennis-worker.js).
+// Es un script clásico para poder cargarlo con <script> y con importScripts();
+// deja sus funciones en self.TennisWasm.
+
+"use strict";
+
+(function () {
+  // Compila en streaming mientras se descarga; si el servidor no sirve el .wasm
+  // como application/wasm, se recurre a descargarlo completo y compilarlo después
+  async function compileWasm(url) {
+    try {
+      return await WebAssembly.compileStreaming(fetch(url));
+    } catch (err) {
+      console.warn("compileStreaming no disponible, compilando sin streaming:", err);
+      const response = await fetch(url);
+      return WebAssembly.compile(await response.arrayBuffer());
+    }
+  }
+
+  // Duración de la descarga de un recurso según Resource Timing (NaN si no consta)
+  function resourceDuration(url) {
+    const entries = performance.getEntriesByName(new URL(url, self.location.href).href);
+    const entry = entries[entries.length - 1];
+    return entry ? entry.responseEnd - entry.startTime : NaN;
+  }
+
+  // Crea el módulo con createTennisEmulatorModule (ya cargado) y un instantiateWasm
+  // propio que compila e instancia por separado para medir cada fase en
+  // timings.compileMs y timings.instantiateMs. Con instantiateWasm propio,
+  // Emscripten no se entera de los fallos de compilación o instanciación y su
+  // promesa no se resolvería nunca: la promesa devuelta se rechaza en ese caso.
+  function createModule(moduleArgs, wasmUrl, timings) {
+    const factory = self.createTennisEmulatorModule;
+    if (!factory) {
+      return Promise.reject(new Error("createTennisEmulatorModule no encontrado"));
+    }
+
+    let rejectInstantiation = () => {};
+    const instantiationFailed = new Promise((_, reject) => {
+      rejectInstantiation = reject;
+    });
+
+    moduleArgs.instantiateWasm = (imports, receiveInstance) => {
+      const compileStart = performance.now();
+      compileWasm(wasmUrl)
+        .then((wasmModule) => {
+          timings.compileMs = performance.now() - compileStart;
+          const instantiateStart = performance.now();
+          return WebAssembly.instantiate(wasmModule, imports).then((instance) => {
+            timings.instantiateMs = performance.now() - instantiateStart;
+            receiveInstance(instance, wasmModule);
+          });
+        })
+        .catch((err) => {
+          console.error("Error instanciando WASM:", err);
+          rejectInstantiation(err);
+        });
+      return {}; // La instanciación es asíncrona
+    };
+
+    return Promise.race([factory(moduleArgs), instantiationFailed]);
+  }
+
+  self.TennisWasm = { compileWasm, resourceDuration, createModule };
+})();
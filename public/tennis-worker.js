@@ -0,0 +1,243 @@
+// Worker de render: ejecuta el módulo WebAssembly (física + WebGL) sobre un
+// OffscreenCanvas fuera del hilo principal. El hilo principal (src/renderWorker.ts)
+// le envía el canvas, las llamadas a funciones exportadas y la entrada de ratón y
+// teclado; el worker le devuelve los resultados y los eventos del módulo.
+//
+// Mensajes recibidos:
+//   { type: "init", canvas, loaderUrl, scriptUrl, wasmUrl, devicePixelRatio, cssWidth, cssHeight }
+//   { type: "call", id, name, args }      name: "_shootBall", "ccall", "FS.readFile"...
+//   { type: "input", kind, ... }          kind: "move" | "button" | "wheel" | "key"
+//   { type: "resize", cssWidth, cssHeight }
+// Mensajes enviados:
+//   { type: "ready" }
+//   { type: "result", id, value } | { type: "result", id, error }
+//   { type: "event", name, payload }      onStartupMetrics, onJobUpdate, onQualityChange, onBranchChange, onSimulationEvents (tiempos en el reloj del worker)
+//   { type: "error", message }
+
+"use strict";
+
+let tennisModule = null;
+let canvasCssSize = { width: 0, height: 0 };
+const pendingCalls = [];
+
+// El código de Emscripten, GLFW y raylib registra listeners y consulta el DOM al
+// crear la ventana. En un worker no hay DOM: estos sustitutos mínimos hacen que
+// esas llamadas no fallen. Los eventos reales llegan por mensajes ("input").
+//
+// Qué se sustituye y por qué (todo lo demás no existe en el worker):
+//   canvas.style, canvas.id        GLFW/raylib escriben el cursor y el tamaño CSS; el id
+//                                  es el que buscan los selectores "#canvas"
+//   canvas.getBoundingClientRect   conversión de coordenadas de ratón y tamaño CSS del
+//                                  canvas; devuelve el tamaño que envía el hilo principal
+//   window = self                  el glue usa window.* y window.addEventListener (el
+//                                  ámbito del worker ya es un EventTarget)
+//   devicePixelRatio               escala del framebuffer (copiado del hilo principal)
+//   matchMedia                     GLFW escucha cambios de resolución; nunca coincide
+//   screen                         tamaño del monitor (GetMonitorWidth/Height)
+//   document.title                 SetWindowTitle
+//   document.body, documentElement solo .style (cursor y pantalla completa) y append/remove
+//   fullscreenElement,             siempre null: sin pantalla completa ni captura del ratón
+//     pointerLockElement
+//   document.add/removeEventListener  listeners de pantalla completa, visibilidad y teclado;
+//                                  no se disparan nunca (la entrada llega por mensajes)
+//   querySelector, getElementById  siempre devuelven el canvas (único elemento)
+//   createElement                  elemento inerte (sin contexto) para las comprobaciones
+//                                  de soporte del glue
+//
+// Si el glue (p. ej. tras actualizar raylib o Emscripten) lee una propiedad que no
+// está aquí, warnOnMissing lo avisa en la consola una vez por propiedad en lugar de
+// devolver undefined en silencio.
+function warnOnMissing(name, target) {
+  const warned = new Set();
+  return new Proxy(target, {
+    get(object, prop, receiver) {
+      if (typeof prop === "string" && !(prop in object) && !warned.has(prop)) {
+        warned.add(prop);
+        console.warn(`[Worker] ${name}.${prop} no existe en el worker (añadirlo en installDomShims)`);
+      }
+      return Reflect.get(object, prop, receiver);
+    },
+  });
+}
+
+function installDomShims(canvas, devicePixelRatio) {
+  const noop = () => {};
+  const mediaQuery = warnOnMissing("matchMedia()", {
+    matches: false,
+    addEventListener: noop,
+    removeEventListener: noop,
+    addListener: noop,
+    removeListener: noop,
+  });
+
+  canvas.style = warnOnMissing("canvas.style", {});
+  canvas.id = "tennis-emulator-canvas";
+  canvas.getBoundingClientRect = () => ({
+    left: 0,
+    top: 0,
+    x: 0,
+    y: 0,
+    width: canvasCssSize.width,
+    height: canvasCssSize.height,
+    right: canvasCssSize.width,
+    bottom: canvasCssSize.height,
+  });
+
+  self.window = self;
+  self.devicePixelRatio = devicePixelRatio;
+  self.matchMedia = () => mediaQuery;
+  self.screen = warnOnMissing("screen", {
+    width: canvas.width,
+    height: canvas.height,
+    availWidth: canvas.width,
+    availHeight: canvas.height,
+  });
+  self.document = warnOnMissing("document", {
+    title: "",
+    body: warnOnMissing("document.body", { appendChild: noop, removeChild: noop, style: {} }),
+    documentElement: warnOnMissing("document.documentElement", { style: {} }),
+    fullscreenElement: null,
+    pointerLockElement: null,
+    addEventListener: noop,
+    removeEventListener: noop,
+    querySelector: () => canvas,
+    getElementById: () => canvas,
+    createElement: () => ({ style: {}, getContext: () => null, addEventListener: noop }),
+  });
+}
+
+function postEvent(name, payload, transfer) {
+  self.postMessage({ type: "event", name, payload }, transfer || []);
+}
+
+// Resuelve "FS.readFile" o "_shootBall" a la función del módulo y su objeto
+function resolveFunction(name) {
+  const parts = name.split(".");
+  let owner = tennisModule;
+  for (let i = 0; i < parts.length - 1; i++) {
+    owner = owner ? owner[parts[i]] : undefined;
+  }
+  const fn = owner ? owner[parts[parts.length - 1]] : undefined;
+  return typeof fn === "function" ? { owner, fn } : null;
+}
+
+// Resultados binarios: solo se transfieren los buffers que el worker sabe nuevos
+// (FS.readFile devuelve un array propio). Cualquier otra vista podría apuntar a la
+// memoria del módulo: transferir su buffer lo separaría (HEAPU8 quedaría inservible)
+// y clonarla copiaría el heap entero, así que se copia solo la vista.
+const OWNED_BUFFER_RESULTS = new Set(["FS.readFile"]);
+
+function handleCall(message) {
+  const target = resolveFunction(message.name);
+  if (!target) {
+    self.postMessage({ type: "result", id: message.id, error: "Función no exportada: " + message.name });
+    return;
+  }
+  try {
+    let value = target.fn.apply(target.owner, message.args || []);
+    let transfer = [];
+    if (ArrayBuffer.isView(value) && !(value instanceof DataView)) {
+      if (!OWNED_BUFFER_RESULTS.has(message.name)) {
+        value = value.slice();
+      }
+      transfer = [value.buffer];
+    }
+    self.postMessage({ type: "result", id: message.id, value }, transfer);
+  } catch (err) {
+    self.postMessage({ type: "result", id: message.id, error: String(err) });
+  }
+}
+
+function handleInput(message) {
+  switch (message.kind) {
+    case "move":
+      tennisModule._forwardMouseMove(message.x, message.y);
+      break;
+    case "button":
+      tennisModule._forwardMouseButton(message.button, message.down ? 1 : 0);
+      break;
+    case "wheel":
+      tennisModule._forwardMouseWheel(message.delta);
+      break;
+    case "key":
+      tennisModule._forwardKey(message.key, message.down ? 1 : 0);
+      break;
+  }
+}
+
+async function init(message) {
+  const t0 = performance.now();
+  canvasCssSize = { width: message.cssWidth, height: message.cssHeight };
+  installDomShims(message.canvas, message.devicePixelRatio);
+
+  importScripts(message.loaderUrl, message.scriptUrl);
+  const scriptMs = performance.now() - t0;
+  const timings = { compileMs: 0, instantiateMs: 0 };
+
+  tennisModule = await self.TennisWasm.createModule(
+    {
+      canvas: message.canvas,
+      // Sin document.currentScript: los hilos de trabajo necesitan la URL del script
+      mainScriptUrlOrBlob: message.scriptUrl,
+      locateFile: (path) => new URL(path, new URL(message.scriptUrl, self.location.href)).href,
+      print: (t) => console.log("[WASM]", t),
+      printErr: (t) => console.error("[WASM]", t),
+
+      onStartupMetrics: (metrics) => {
+        const downloadMs = self.TennisWasm.resourceDuration(message.wasmUrl);
+        const timeOrigin = performance.timeOrigin;
+        postEvent("onStartupMetrics", { ...metrics, timeOrigin, scriptMs, downloadMs, ...timings });
+      },
+
+      onJobUpdate: (update) => {
+        postEvent("onJobUpdate", update, [update.values.buffer]);
+      },
+
+      onQualityChange: (quality) => {
+        postEvent("onQualityChange", quality);
+      },
+
+      onBranchChange: (branches) => {
+        postEvent("onBranchChange", branches);
+      },
+
+      onSimulationEvents: (batch) => {
+        postEvent("onSimulationEvents", batch, [batch.data]);
+      },
+    },
+    message.wasmUrl,
+    timings
+  );
+
+  tennisModule._setInputForwarding(1);
+  self.postMessage({ type: "ready" });
+
+  // Llamadas recibidas mientras el módulo se cargaba
+  for (const call of pendingCalls.splice(0)) {
+    handleCall(call);
+  }
+}
+
+self.onmessage = (event) => {
+  const message = event.data;
+  switch (message.type) {
+    case "init":
+      init(message).catch((err) => self.postMessage({ type: "error", message: String(err) }));
+      break;
+    case "call":
+      if (tennisModule) {
+        handleCall(message);
+      } else {
+        pendingCalls.push(message);
+      }
+      break;
+    case "input":
+      if (tennisModule) {
+        handleInput(message);
+      }
+      break;
+    case "resize":
+      canvasCssSize = { width: message.cssWidth, height: message.cssHeight };
+      break;
+  }
+};
@@ -1,85 +1,107 @@
 import { useEffect, useRef, useState } from "react";
 import "./App.css";
+import { loadTennisModule, type StartupTimings } from "./wasmLoader";
+import { isWorkerRenderSupported, loadTennisWorker } from "./renderWorker";
+import ClearanceHeatmap from "./ClearanceHeatmap";
+import {
+  decodeSimulationEvents,
+  type SimulationEvent,
+  type SimulationEventBatch,
+} from "./simulationEvents";
+
+// ?render=worker ejecuta la simulación y el render en un worker con OffscreenCanvas
+const RENDER_IN_WORKER = new URLSearchParams(window.location.search).get("render") === "worker";
+
+const REWIND_STEP_MS = 250;
+
+type QualityState = { level: number; automatic: boolean };
+type BranchState = { count: number; active: number };
+
+// Texto del último evento de la simulación
+function describeEvent(event: SimulationEvent): string {
+  switch (event.type) {
+    case "bounce":
+      return `bote a ${event.value.toFixed(0)} u/s`;
+    case "netHit":
+      return `choque con la red a ${event.value.toFixed(1)} u de altura`;
+    case "netCrossed":
+      return `pasa la red con ${event.value.toFixed(1)} u de margen`;
+    case "stop":
+      return "pelota parada";
+  }
+}
+
+const secondaryButtonStyle = {
+  padding: "6px 12px",
+  marginLeft: "8px",
+  fontSize: "14px",
+  border: "1px solid #888",
+  borderRadius: "4px",
+  cursor: "pointer",
+};
 
 function App() {
   const canvasRef = useRef<HTMLCanvasElement>(null);
   const wasmModuleRef = useRef<any>(null);
   const [isLoading, setIsLoading] = useState(true);
+  const [loadError, setLoadError] = useState<string | null>(null);
   const [angle, setAngle] = useState(0); // Ángulo horizontal en grados
   const [elevation, setElevation] = useState(-20); // Ángulo vertical en grados
   const [speed, setSpeed] = useState(1500); // Velocidad inicial
+  const [startupTimings, setStartupTimings] = useState<StartupTimings | null>(null);
+  const [isPaused, setIsPaused] = useState(false);
+  const [quality, setQuality] = useState<QualityState>({ level: 0, automatic: true });
+  const [qualityLevelCount, setQualityLevelCount] = useState(0); // Lo fija el módulo al cargar
+  const [lastEvent, setLastEvent] = useState<SimulationEvent | null>(null);
+  const [branches, setBranches] = useState<BranchState>({ count: 1, active: 0 });
 
   useEffect(() => {
-    const initWasm = async () => {
-      const canvas = canvasRef.current;
-      if (!canvas) {
-        console.error("Canvas no encontrado");
-        return;
-      }
+    const canvas = canvasRef.current;
+    if (!canvas) {
+      console.error("Canvas no encontrado");
+      return;
+    }
 
-      // Asegurarse de que el canvas esté en el DOM y visible
-      canvas.id = "tennis-emulator-canvas";
-      canvas.style.display = "block";
-
-      // Esperar un frame para asegurar que el canvas esté completamente en el DOM
-      await new Promise((resolve) => setTimeout(resolve, 100));
-
-      const script = document.createElement("script");
-      script.src = "/cpp/tennis_emulator.js";
-      script.onload = () => {
-        const createModule = (window as any).createTennisEmulatorModule;
-        if (!createModule) {
-          console.error("createTennisEmulatorModule no encontrado");
-          setIsLoading(false);
-          return;
-        }
-
-        console.log("Inicializando módulo WASM con canvas:", canvas.id);
-        createModule({
-          canvas: canvas,
-          noInitialRun: true, // Ejecutar main() manualmente después
-          locateFile: (path: string) => "/cpp/" + path,
-          print: (t: string) => console.log("[WASM]", t),
-          printErr: (t: string) => console.error("[WASM]", t),
-        })
-          .then((module: any) => {
-            console.log("WASM listo", module);
-            wasmModuleRef.current = module;
-
-            // Ejecutar main() manualmente después de que el módulo esté listo
-            if (module._main) {
-              console.log("Ejecutando main()...");
-              try {
-                module._main();
-              } catch (err) {
-                console.error("Error ejecutando main():", err);
-              }
-            } else {
-              console.warn("_main no encontrado en el módulo");
-            }
+    // Asegurarse de que el canvas esté en el DOM y visible
+    canvas.id = "tennis-emulator-canvas";
+    canvas.style.display = "block";
 
+    // El canvas ya está montado cuando se ejecuta el efecto: se carga el módulo
+    // sin esperas y main() se ejecuta automáticamente al estar listo el runtime
+    const inWorker = RENDER_IN_WORKER && isWorkerRenderSupported(canvas);
+    if (RENDER_IN_WORKER && !inWorker) {
+      console.warn("OffscreenCanvas no disponible: se renderiza en el hilo principal");
+    }
+    const load = inWorker ? loadTennisWorker : loadTennisModule;
+    load(canvas, { onStartupTimings: setStartupTimings })
+      .then((module: any) => {
+        console.log("WASM listo", module);
+        wasmModuleRef.current = module;
+        module.onQualityChange = (change: QualityState) =>
+          setQuality({ level: change.level, automatic: change.automatic });
+        module.onBranchChange = (change: BranchState) => setBranches(change);
+        // Un lote por frame, solo en los frames con eventos
+        module.onSimulationEvents = (batch: SimulationEventBatch) => {
+          const events = decodeSimulationEvents(batch);
+          if (events.length > 0) {
+            setLastEvent(events[events.length - 1]);
+          }
+        };
+        // El número de niveles lo define el regulador de calidad del módulo, y su
+        // primer ajuste ocurre en main(), antes de registrar el callback
+        return Promise.all([module._getQualityLevelCount(), module._getQualityLevel()]).then(
+          ([levelCount, level]: number[]) => {
+            setQualityLevelCount(levelCount);
+            setQuality((current) => ({ ...current, level }));
             setIsLoading(false);
-          })
-          .catch((err: any) => {
-            console.error("Error cargando WASM:", err);
-            setIsLoading(false);
-          });
-      };
-
-      script.onerror = () => {
-        console.error("Error cargando script WASM");
+          }
+        );
+      })
+      .catch((err: any) => {
+        console.error("Error cargando WASM:", err);
+        setLoadError(String(err));
         setIsLoading(false);
-      };
-
-      document.body.appendChild(script);
-    };
-
-    initWasm();
-
-    // Cleanup
-    return () => {
-      // No removemos el script para evitar problemas si React recarga el componente
-    };
+      });
   }, []);
 
   const handleSetAngle = () => {
@@ -99,17 +121,60 @@ function App() {
       // Luego disparar
       if (wasmModuleRef.current._shootBall) {
         wasmModuleRef.current._shootBall();
+        setIsPaused(false);
       }
     } else {
       console.warn("WASM module not ready yet");
     }
   };
 
+  const handleTogglePause = () => {
+    if (wasmModuleRef.current) {
+      wasmModuleRef.current._setSimulationPaused(isPaused ? 0 : 1);
+      setIsPaused(!isPaused);
+    }
+  };
+
+  // Rebobina y deja la simulación pausada en ese instante
+  const handleRewind = () => {
+    if (wasmModuleRef.current) {
+      wasmModuleRef.current._rewindSimulation(REWIND_STEP_MS);
+      setIsPaused(true);
+    }
+  };
+
+  // Golpe alternativo desde la posición actual de la pelota (reanuda la simulación)
+  const handleShootFromHere = () => {
+    if (wasmModuleRef.current) {
+      wasmModuleRef.current._setBallAngle(angle, elevation, speed);
+      wasmModuleRef.current._shootBallFromCurrentPosition();
+      setIsPaused(false);
+    }
+  };
+
+  // Salta al último instante de otra rama del historial (queda en pausa)
+  const handleSelectBranch = (branch: number) => {
+    if (wasmModuleRef.current) {
+      wasmModuleRef.current._selectSimulationBranch(branch);
+      setIsPaused(true);
+    }
+  };
+
+  // "auto" devuelve el control al regulador; un número fija ese nivel
+  const handleQualityChange = (value: string) => {
+    if (wasmModuleRef.current) {
+      const level = value === "auto" ? -1 : Number(value);
+      wasmModuleRef.current._setQualityLevel(level);
+      setQuality((current) => ({ level: level < 0 ? current.level : level, automatic: level < 0 }));
+    }
+  };
+
   return (
     <div className="app">
       <h1>Tennis Emulator</h1>
       {isLoading && <p>Cargando WebAssembly...</p>}
-      {!isLoading && (
+      {loadError && <p style={{ color: "#c00" }}>Error cargando WebAssembly: {loadError}</p>}
+      {!isLoading && !loadError && (
         <div
           style={{
             marginBottom: "10px",
@@ -154,6 +219,14 @@ function App() {
               />
             </label>
           </div>
+          {wasmModuleRef.current && (
+            <ClearanceHeatmap
+              module={wasmModuleRef.current}
+              speed={speed}
+              angle={angle}
+              elevation={elevation}
+            />
+          )}
           <button
             onClick={handleShootBall}
             style={{
@@ -174,8 +247,64 @@ function App() {
           >
             Disparar Pelota
           </button>
+          <button onClick={handleTogglePause} style={secondaryButtonStyle}>
+            {isPaused ? "Continuar" : "Pausa"}
+          </button>
+          <button onClick={handleRewind} style={secondaryButtonStyle}>
+            ⏪ {REWIND_STEP_MS} ms
+          </button>
+          <button onClick={handleShootFromHere} style={secondaryButtonStyle}>
+            Golpear desde aquí
+          </button>
+          {branches.count > 1 && (
+            <label style={{ marginLeft: "12px", fontSize: "14px" }}>
+              Rama:
+              <select
+                value={branches.active}
+                onChange={(e) => handleSelectBranch(Number(e.target.value))}
+                style={{ marginLeft: "6px" }}
+              >
+                {Array.from({ length: branches.count }, (_, branch) => (
+                  <option key={branch} value={branch}>
+                    {branch + 1}
+                  </option>
+                ))}
+              </select>
+            </label>
+          )}
+          <label style={{ marginLeft: "12px", fontSize: "14px" }}>
+            Calidad: {quality.level}/{qualityLevelCount - 1}
+            <select
+              value={quality.automatic ? "auto" : String(quality.level)}
+              onChange={(e) => handleQualityChange(e.target.value)}
+              style={{ marginLeft: "6px" }}
+            >
+              <option value="auto">Automática</option>
+              {Array.from({ length: qualityLevelCount }, (_, level) => (
+                <option key={level} value={level}>
+                  Nivel {level}
+                </option>
+              ))}
+            </select>
+          </label>
         </div>
       )}
+      {lastEvent && (
+        <p style={{ fontSize: "12px", color: "#555", margin: "0 0 6px" }}>
+          Último evento ({lastEvent.time.toFixed(2)} s): {describeEvent(lastEvent)}
+        </p>
+      )}
+      {startupTimings && (
+        <p style={{ fontSize: "12px", color: "#888", margin: "0 0 6px" }}>
+          Arranque: JS {startupTimings.scriptMs.toFixed(0)} ms · descarga WASM{" "}
+          {startupTimings.downloadMs.toFixed(0)} ms · compilación{" "}
+          {startupTimings.compileMs.toFixed(0)} ms · instanciación{" "}
+          {startupTimings.instantiateMs.toFixed(0)} ms · InitWindow{" "}
+          {startupTimings.initWindowMs.toFixed(0)} ms · primer frame{" "}
+          {startupTimings.firstFrameMs.toFixed(0)} ms · total{" "}
+          {startupTimings.totalMs.toFixed(0)} ms
+        </p>
+      )}
       <canvas
         ref={canvasRef}
         id="tennis-emulator-canvas"
@@ -0,0 +1,125 @@
+import { useEffect, useRef, useState } from "react";
+import { onJobUpdate, type JobUpdate } from "./jobUpdates";
+
+interface ClearanceHeatmapProps {
+  module: any;
+  speed: number;
+  angle: number;
+  elevation: number;
+}
+
+const MIN_ANGLE = -90;
+const MAX_ANGLE = 90;
+const MIN_ELEVATION = -45;
+const MAX_ELEVATION = 45;
+const CELL_SIZE = 3; // Píxeles por celda
+
+// Color de una celda: verde si pasa la red (más intenso cuanto más justo),
+// rojo si la toca y gris si no llega
+function clearanceColor(clearance: number): [number, number, number] {
+  if (Number.isNaN(clearance)) {
+    return [90, 90, 90];
+  }
+  if (clearance < 0) {
+    return [200, 40, 40];
+  }
+  const t = Math.min(clearance / 300, 1);
+  return [40, Math.round(220 - 140 * t), 60];
+}
+
+// Mapa de margen sobre la red (ángulo × elevación) calculado en segundo plano.
+// Las filas llegan como resultados parciales y se pintan según llegan; al mover
+// el slider de velocidad se cancela el cálculo anterior y empieza uno nuevo.
+// Las funciones del módulo pueden devolver promesas (modo worker).
+function ClearanceHeatmap({ module, speed, angle, elevation }: ClearanceHeatmapProps) {
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+  const [progress, setProgress] = useState(0);
+  const [size, setSize] = useState<{ columns: number; rows: number } | null>(null);
+
+  useEffect(() => {
+    Promise.all([module._getClearanceHeatmapColumns(), module._getClearanceHeatmapRows()]).then(
+      ([columns, rows]: number[]) => setSize({ columns, rows })
+    );
+  }, [module]);
+
+  const columns = size?.columns ?? 0;
+  const rows = size?.rows ?? 0;
+
+  useEffect(() => {
+    if (!size) {
+      return;
+    }
+    const ctx = canvasRef.current?.getContext("2d");
+    ctx?.clearRect(0, 0, columns * CELL_SIZE, rows * CELL_SIZE);
+    setProgress(0);
+
+    const handleUpdate = (update: JobUpdate) => {
+      if (update.type === "partial" && ctx) {
+        for (let i = 0; i < update.values.length; i++) {
+          const index = update.offset + i;
+          const column = index % columns;
+          const row = Math.floor(index / columns);
+          const [r, g, b] = clearanceColor(update.values[i]);
+          ctx.fillStyle = `rgb(${r}, ${g}, ${b})`;
+          // Elevación máxima arriba
+          ctx.fillRect(column * CELL_SIZE, (rows - 1 - row) * CELL_SIZE, CELL_SIZE, CELL_SIZE);
+        }
+      }
+      setProgress(update.type === "done" ? 1 : update.progress);
+    };
+
+    // Las notificaciones del cálculo anterior (cancelado al empezar este) ya no
+    // tienen listener y se descartan
+    let stopListening: (() => void) | undefined;
+    let replaced = false;
+    Promise.resolve(module._startClearanceHeatmap(speed, 0)).then((id: number) => {
+      if (!replaced) {
+        stopListening = onJobUpdate(module, id, handleUpdate);
+      }
+    });
+    return () => {
+      replaced = true;
+      stopListening?.();
+    };
+  }, [module, speed, size, columns, rows]);
+
+  if (!size) {
+    return null;
+  }
+
+  const markerLeft = ((angle - MIN_ANGLE) / (MAX_ANGLE - MIN_ANGLE)) * 100;
+  const markerTop = ((MAX_ELEVATION - elevation) / (MAX_ELEVATION - MIN_ELEVATION)) * 100;
+
+  return (
+    <div style={{ marginBottom: "10px" }}>
+      <div style={{ fontSize: "12px", marginBottom: "4px" }}>
+        Margen sobre la red (ángulo × elevación)
+        {progress < 1 && ` — calculando ${Math.round(progress * 100)}%`}
+      </div>
+      <div style={{ position: "relative", display: "inline-block" }}>
+        <canvas
+          ref={canvasRef}
+          width={columns * CELL_SIZE}
+          height={rows * CELL_SIZE}
+          style={{ display: "block", backgroundColor: "#222" }}
+        />
+        <div
+          style={{
+            position: "absolute",
+            left: `${markerLeft}%`,
+            top: `${markerTop}%`,
+            width: "6px",
+            height: "6px",
+            marginLeft: "-3px",
+            marginTop: "-3px",
+            border: "1px solid white",
+            borderRadius: "50%",
+            pointerEvents: "none",
+          }}
+        />
+      </div>
+    </div>
+  );
+}
+
+export default ClearanceHeatmap;
@@ -2,55 +2,50 @@
 #define BALL_H
 
 #include "raylib.h"
-#include <cmath>  // al inicio del archivo
+#include "Body.h"
+
+// Política de Body<2> para un suelo en coordenadas de pantalla (Y crece hacia abajo)
+struct ScreenFloorPhysics {
+    static constexpr int UP_AXIS = 1;
+    static constexpr float SURFACE_SIDE = -1.0f;
+    float restitution; // Coeficiente de restitución
+
+    float Gravity() const { return 980.0f; }      // Gravedad en px/s^2 (ajustable)
+    float Restitution() const { return restitution; }
+    float Friction() const { return 1.0f; }
+    float StopVelocity() const { return 20.0f; }
+};
 
 class Ball {
 private:
-    Vector2 position;
+    Body<2> body;
     float radius;
     Color color;
     float speed;
-    bool isMoving;
-    float velocityY = 0.0f;       // Velocidad vertical
-    const float gravity = 980.0f; // Gravedad en px/s^2 (ajustable)
-    float restitution; // Coeficiente de restitución
-    const float minHeight = 1.0f; // Altura mínima para detener la pelota
+    ScreenFloorPhysics physics;
 
 public:
     Ball(float x, float radius, float initialHeight, Color col, float spd, float rest) 
-        : position({x, initialHeight}), radius(radius), color(col), speed(spd), isMoving(true), restitution(rest) {}
+        : body{{x, initialHeight}, {0.0f, 0.0f}, true}, radius(radius), color(col), speed(spd), physics{rest} {}
       
-        void Update(float deltaTime, int screenHeight) {
-            if (!isMoving) {
-                return;
-            }
-        
-            velocityY += gravity * deltaTime;       
-            position.y += velocityY * deltaTime;
-        
-            float floorY = screenHeight - radius;
-            if (position.y >= floorY) {
-                position.y = floorY;
-                velocityY = -velocityY * restitution;
-        
-                // stop condition
-                if (fabs(velocityY) < 20.0f) { 
-                    velocityY = 0.0f;
-                    isMoving = false;
-                }
-            }
+    void Update(float deltaTime, int screenHeight) {
+        if (!body.isMoving) {
+            return;
         }
-    
+
+        Physics::Integrate(body, deltaTime, physics);
+        Physics::ResolveSurface(body, screenHeight - radius, physics);
+    }
 
     void Draw() {
-        DrawCircle(position.x, position.y, radius, color);
-        DrawCircleLines(position.x, position.y, radius, BLACK);
+        DrawCircle(body.position[0], body.position[1], radius, color);
+        DrawCircleLines(body.position[0], body.position[1], radius, BLACK);
     }
 
     // Getters
-    bool GetIsMoving() const { return isMoving; }
-    float GetX() const { return position.x; }
-    float GetY() const { return position.y; }
+    bool GetIsMoving() const { return body.isMoving; }
+    float GetX() const { return body.position[0]; }
+    float GetY() const { return body.position[1]; }
     float GetRadius() const { return radius; }
 };
 
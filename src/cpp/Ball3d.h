@@ -3,170 +3,134 @@
 
 #include "raylib.h"
 #include "Court.h"
+#include "Log.h"
+#include "BallState.h"
 #include <cmath>
-#include <vector>
+#include <cstdint>
 
+// Pelota 3D que se dibuja en pantalla: estado de simulación compacto (BallState)
+// más los datos que solo necesita el render (radio, color y estela)
 class Ball3D {
 private:
-    Vector3 position;       // Posición 3D
+    BallState state;        // Posición, velocidad, spin y si se mueve
     float radius;
     Color color;
 
-    Vector3 velocity;       // Velocidad 3D
-    bool isMoving;
-    float previousZ;        // Posición Z anterior para detectar cruce de la red
-    std::vector<Vector3> trail;  // Estela de posiciones anteriores
+    static const int MAX_TRAIL_POINTS = 30;  // Número máximo de puntos en la estela
+    Vector3 trail[MAX_TRAIL_POINTS];         // Estela de posiciones anteriores (buffer circular)
+    uint8_t trailHead = 0;                   // Índice del punto más antiguo
+    uint8_t trailCount = 0;
     bool showTrail;         // Indica si se muestra la estela
-    static const size_t MAX_TRAIL_POINTS = 30;  // Número máximo de puntos en la estela
-
-    const float gravity = 980.0f;      // Gravedad en px/s^2
-    const float restitution = 0.7f;    // Rebote vertical
-    const float minVelocity = 20.0f;   // Umbral para detener rebote
-    const float frictionXZ = 0.98f;    // Reducción de velocidad horizontal al rebotar
-    Vector3 spin;                       // Efecto de spin (X,Z) en px/s
-
-    // Función para detectar y manejar colisión con la red
-    void CheckNetCollision(Vector3& newPosition, float netZ, float floorY, const Court& court) {
-        // Determinar la dirección del movimiento en Z
-        float deltaZ = newPosition.z - position.z;
-        if (std::abs(deltaZ) <= 0.001f) {  // No hay movimiento significativo en Z
-            return;
-        }
-        
-        // Calcular el borde de la pelota que está más cerca de la red
-        // Si se mueve hacia adelante (deltaZ > 0), el borde delantero es position.z + radius
-        // Si se mueve hacia atrás (deltaZ < 0), el borde trasero es position.z - radius
-        float previousEdgeZ = position.z + (deltaZ > 0 ? radius : -radius);
-        float newEdgeZ = newPosition.z + (deltaZ > 0 ? radius : -radius);
-        
-        // Verificar si el borde de la pelota está cruzando o cruzó la red
-        bool previousWasBeforeNet = previousEdgeZ < netZ;
-        bool newIsAfterNet = newEdgeZ >= netZ;
-        bool previousWasAfterNet = previousEdgeZ > netZ;
-        bool newIsBeforeNet = newEdgeZ < netZ;
-        
-        // Si el borde de la pelota cruzó la red
-        if (!((previousWasBeforeNet && newIsAfterNet) || (previousWasAfterNet && newIsBeforeNet))) {
-            return;
-        }
-        
-        // Verificar si la altura de la pelota es menor que la altura de la red
-        // Usar la posición intermedia (en la red) para la verificación
-        float t = (netZ - previousEdgeZ) / (newEdgeZ - previousEdgeZ);
-        float collisionX = position.x + (newPosition.x - position.x) * t;
-        float collisionY = position.y + (newPosition.y - position.y) * t;
-        
-        float netHeight = court.GetNetHeightAtX(collisionX);
-        float ballHeightAboveFloor = collisionY - floorY;
-        
-        // Si cualquier parte de la pelota está por debajo de la altura de la red
-        // (el punto más bajo de la pelota es ballHeightAboveFloor - radius)
-        if (ballHeightAboveFloor - radius >= netHeight) {
-            return;
-        }
-        
-        // Hay colisión: reposicionar la pelota del lado correcto de la red
-        // Colocar el borde exterior de la pelota justo antes/después de la red
-        if (previousWasBeforeNet) {
-            // Venía desde antes de la red, dejarla justo antes
-            newPosition.z = netZ - radius - 0.1f; // Pequeño margen para evitar que quede exactamente en la red
+    int trailLength = MAX_TRAIL_POINTS;  // Puntos de la estela que se dibujan (los más recientes)
+    int sphereRings = 16;   // Teselado de las esferas (16x16 es lo que usa DrawSphere)
+    int sphereSlices = 16;
+
+    void ClearTrail() {
+        trailHead = 0;
+        trailCount = 0;
+    }
+
+    void PushTrail(Vector3 pos) {
+        if (trailCount < MAX_TRAIL_POINTS) {
+            trail[(trailHead + trailCount) % MAX_TRAIL_POINTS] = pos;
+            trailCount++;
         } else {
-            // Venía desde después de la red, dejarla justo después
-            newPosition.z = netZ + radius + 0.1f; // Pequeño margen
+            // Sobrescribir el punto más antiguo
+            trail[trailHead] = pos;
+            trailHead = (trailHead + 1) % MAX_TRAIL_POINTS;
         }
-        
-        // Detener el movimiento horizontal y dejar que caiga por gravedad
-        velocity.x = 0.0f;
-        velocity.z = 0.0f;
-        spin = {0.0f, 0.0f, 0.0f};
     }
 
 public:
     Ball3D(Vector3 pos, float rad, Color col, Vector3 vel, Vector3 spn = {0.0f, 0.0f, 0.0f}, bool showTrail = true)
-        : position(pos), radius(rad), color(col), velocity(vel), spin(spn), isMoving(true), previousZ(pos.z), showTrail(showTrail) {
-        trail.clear();
-        trail.push_back(pos);  // Inicializar con la posición inicial
+        : state(BallState::Make(pos, vel, spn)), radius(rad), color(col), showTrail(showTrail) {
+        PushTrail(pos);  // Inicializar con la posición inicial
     }
 
-        void Update(float deltaTime, float floorY, float maxX, float maxZ, float netZ, const Court& court) {
-            if (!isMoving) return;
-        
-            // Aplicar gravedad vertical (hacia abajo)
-            velocity.y -= gravity * deltaTime;
-        
-            // Calcular nueva posición
-            Vector3 newPosition = position;
-            newPosition.x += velocity.x * deltaTime;
-            newPosition.y += velocity.y * deltaTime;
-            newPosition.z += velocity.z * deltaTime;
-        
-            // Detectar colisión con la red ANTES de actualizar la posición
-            CheckNetCollision(newPosition, netZ, floorY, court);
-            
-            // Actualizar posición
-            position = newPosition;
-            
+        // events (opcional): cola donde la física deja los eventos del paso, con el instante time
+        void Update(float deltaTime, float floorY, float maxX, float maxZ, float netZ, const Court& court,
+                    SimEventQueue* events = nullptr, float time = 0.0f) {
+            if (!state.body.isMoving) return;
+
+            bool bounced = StepBall(state, deltaTime, radius, floorY, netZ, court, events, time);
+
             // Agregar posición actual a la estela
-            trail.push_back(position);
-            if (trail.size() > MAX_TRAIL_POINTS) {
-                trail.erase(trail.begin());  // Eliminar el punto más antiguo
-            }
-            
-            // Guardar posición Z actual para la próxima actualización
-            previousZ = position.z;
-        
-            // Rebote con el suelo
-            if (position.y <= floorY + radius) {
-                position.y = floorY + radius;
-                velocity.y = -velocity.y * restitution;
-        
-                // Aplicar spin lateral y fricción horizontal
-                velocity.x = velocity.x * frictionXZ + spin.x;
-                velocity.z = velocity.z * frictionXZ + spin.z;
-        
-                // Parar la pelota si el rebote vertical es demasiado pequeño
-                if (std::abs(velocity.y) < minVelocity) {
-                    velocity = {0.0f, 0.0f, 0.0f};
-                    isMoving = false;
-                }
+            PushTrail(state.GetPosition());
+
+            if (bounced) {
+                LOG_DEBUG("Bote (x, z, vy):", state.body.position[0], state.body.position[2], state.body.velocity[1]);
             }
         }
-        
+
 
     void Draw() {
         // Dibujar la estela si está habilitada
-        if (showTrail && trail.size() > 0) {
-            for (size_t i = 0; i < trail.size(); i++) {
+        int visible = trailCount < trailLength ? trailCount : trailLength;
+        if (showTrail && visible > 0) {
+            int first = trailCount - visible;  // Se omiten los puntos más antiguos
+            for (int i = 0; i < visible; i++) {
                 // Calcular la opacidad basada en la posición en la estela (más reciente = más opaco)
                 // Los puntos más recientes (i más grande) tienen más opacidad
-                float alpha = (float)(i + 1) / (float)trail.size();
+                float alpha = (float)(i + 1) / (float)visible;
                 Color trailColor = color;
                 trailColor.a = (unsigned char)(alpha * 255);  // Opacidad completa para los más recientes
-                
+
                 // Dibujar esfera del mismo tamaño que la bola en cada punto de la estela
-                DrawSphere(trail[i], radius, trailColor);
+                DrawSphereEx(trail[(trailHead + first + i) % MAX_TRAIL_POINTS], radius, sphereRings, sphereSlices, trailColor);
             }
         }
-        
+
         // Dibujar la pelota
-        DrawSphere(position, radius, color);
+        DrawSphereEx(state.GetPosition(), radius, sphereRings, sphereSlices, color);
         //DrawSphereWires(position, radius, 16, 16, BLACK);
     }
 
     // Resetear la pelota a una posición y velocidad inicial
     void Reset(Vector3 pos, Vector3 vel, Vector3 spn = {0.0f, 0.0f, 0.0f}) {
-        position = pos;
-        velocity = vel;
-        spin = spn;
-        isMoving = true;
-        previousZ = pos.z;
-        trail.clear();  // Limpiar la estela
-        trail.push_back(pos);  // Inicializar con la nueva posición
+        state = BallState::Make(pos, vel, spn);
+        ClearTrail();  // Limpiar la estela
+        PushTrail(pos);  // Inicializar con la nueva posición
+    }
+
+    // Colocar la pelota en una posición calculada fuera (p. ej. al reproducir una
+    // trayectoria). La velocidad es la del desplazamiento de este paso, así que el
+    // estado guardado sigue siendo un estado físico con el que se puede continuar
+    void Follow(Vector3 pos, bool moving, float deltaTime) {
+        Vector3 previous = state.GetPosition();
+        state.SetPosition(pos);
+        if (moving && deltaTime > 0.0f) {
+            state.SetVelocity({(pos.x - previous.x) / deltaTime, (pos.y - previous.y) / deltaTime,
+                               (pos.z - previous.z) / deltaTime});
+        } else {
+            state.SetVelocity({0.0f, 0.0f, 0.0f});
+        }
+        state.body.isMoving = moving;
+        PushTrail(pos);
+    }
+
+    // Detalle de dibujado: la estela guardada no cambia, solo cuántos puntos se dibujan
+    void SetDrawDetail(int trailPoints, int rings, int slices) {
+        trailLength = trailPoints < MAX_TRAIL_POINTS ? trailPoints : MAX_TRAIL_POINTS;
+        sphereRings = rings;
+        sphereSlices = slices;
+    }
+
+    // Restaurar un estado guardado. La estela se reconstruye a partir de las
+    // posiciones anteriores (de la más antigua a la más reciente) en lugar de guardarse
+    void Restore(const BallState& saved, const Vector3* trailPositions, int trailPositionCount) {
+        state = saved;
+        ClearTrail();
+        for (int i = 0; i < trailPositionCount; i++) {
+            PushTrail(trailPositions[i]);
+        }
     }
 
     // Getters
-    bool GetIsMoving() const { return isMoving; }
-    Vector3 GetPosition() const { return position; }
+    bool GetIsMoving() const { return state.body.isMoving; }
+    Vector3 GetPosition() const { return state.GetPosition(); }
+    Vector3 GetVelocity() const { return state.GetVelocity(); }
     float GetRadius() const { return radius; }
+    static constexpr int GetMaxTrailPoints() { return MAX_TRAIL_POINTS; }
+    const BallState& GetState() const { return state; }
 };
 #endif // BALL3D_H
@@ -0,0 +1,75 @@
+#ifndef BALL_POOL_H
+#define BALL_POOL_H
+
+#include "BallState.h"
+#include <cstdint>
+#include <memory>
+
+// Arena de pelotas de capacidad fija: una única reserva contigua de BallState
+// (32 bytes cada uno) y una lista de huecos libres. Reservar y liberar pelotas
+// no toca el heap, así que un simulador por lotes puede manejar millones de
+// pelotas recorriendo memoria contigua.
+class BallPool {
+private:
+    std::unique_ptr<BallState[]> slots;
+    std::unique_ptr<uint32_t[]> freeSlots;  // Pila de huecos liberados
+    uint32_t capacity;
+    uint32_t freeCount = 0;
+    uint32_t highWater = 0;                 // Los huecos [0, highWater) se han usado alguna vez
+
+public:
+    static const uint32_t INVALID_SLOT = UINT32_MAX;
+
+    explicit BallPool(uint32_t capacity)
+        : slots(new BallState[capacity]), freeSlots(new uint32_t[capacity]), capacity(capacity) {}
+
+    // Devuelve el hueco asignado, o INVALID_SLOT si la arena está llena
+    uint32_t Allocate(const BallState& initial) {
+        uint32_t slot;
+        if (freeCount > 0) {
+            slot = freeSlots[--freeCount];
+        } else if (highWater < capacity) {
+            slot = highWater++;
+        } else {
+            return INVALID_SLOT;
+        }
+        slots[slot] = initial;
+        return slot;
+    }
+
+    // Un hueco libre queda como pelota parada, así que StepAll lo salta sin comprobaciones extra
+    void Release(uint32_t slot) {
+        slots[slot].body.isMoving = false;
+        freeSlots[freeCount++] = slot;
+    }
+
+    void Clear() {
+        freeCount = 0;
+        highWater = 0;
+    }
+
+    BallState& operator[](uint32_t slot) { return slots[slot]; }
+    const BallState& operator[](uint32_t slot) const { return slots[slot]; }
+
+    uint32_t GetCapacity() const { return capacity; }
+    uint32_t GetHighWater() const { return highWater; }
+    uint32_t GetLiveCount() const { return highWater - freeCount; }
+
+    // Avanza todas las pelotas en movimiento. Devuelve cuántas siguen moviéndose.
+    // Con una cola, los eventos de cada pelota llevan su hueco como origen.
+    uint32_t StepAll(float deltaTime, float radius, const Court& court,
+                     SimEventQueue* events = nullptr, float time = 0.0f) {
+        const float floorY = court.GetFloorY();
+        const float netZ = court.GetMaxZ() / 2.0f;
+        uint32_t moving = 0;
+        for (uint32_t i = 0; i < highWater; i++) {
+            BallState& ball = slots[i];
+            if (!ball.body.isMoving) continue;
+            StepBall(ball, deltaTime, radius, floorY, netZ, court, events, time, i);
+            moving += ball.body.isMoving ? 1 : 0;
+        }
+        return moving;
+    }
+};
+
+#endif // BALL_POOL_H
@@ -0,0 +1,168 @@
+#ifndef BALL_STATE_H
+#define BALL_STATE_H
+
+#include "raylib.h"
+#include "Body.h"
+#include "Court.h"
+#include "PhysicsProfile.h"
+#include "SimulationEvents.h"
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+// Estado de simulación compacto de una pelota (32 bytes, sin punteros ni memoria dinámica).
+// Los parámetros físicos (gravedad, restitución...) no se guardan aquí: se leen del
+// PhysicsProfile de la pista. El radio, el color y la estela pertenecen al render (Ball3D).
+struct BallState {
+    Body<3> body;           // Posición, velocidad y si se mueve
+    int16_t spinX;          // Spin lateral (X,Z) en 1/SPIN_SCALE px/s. El spin en Y no afecta al bote
+    int16_t spinZ;
+
+    static constexpr float SPIN_SCALE = 64.0f;  // Rango de ±512 px/s con resolución de 1/64
+    static constexpr float MAX_SPIN = 32767.0f / SPIN_SCALE;
+
+    static BallState Make(Vector3 pos, Vector3 vel, Vector3 spin) {
+        BallState state;
+        state.SetPosition(pos);
+        state.SetVelocity(vel);
+        state.SetSpin(spin);
+        state.body.isMoving = true;
+        return state;
+    }
+
+    Vector3 GetPosition() const { return {body.position[0], body.position[1], body.position[2]}; }
+    Vector3 GetVelocity() const { return {body.velocity[0], body.velocity[1], body.velocity[2]}; }
+    Vector3 GetSpin() const { return {spinX / SPIN_SCALE, 0.0f, spinZ / SPIN_SCALE}; }
+
+    void SetPosition(Vector3 pos) {
+        body.position[0] = pos.x;
+        body.position[1] = pos.y;
+        body.position[2] = pos.z;
+    }
+
+    void SetVelocity(Vector3 vel) {
+        body.velocity[0] = vel.x;
+        body.velocity[1] = vel.y;
+        body.velocity[2] = vel.z;
+    }
+
+    void SetSpin(Vector3 spin) {
+        spinX = (int16_t)lroundf(fmaxf(-MAX_SPIN, fminf(MAX_SPIN, spin.x)) * SPIN_SCALE);
+        spinZ = (int16_t)lroundf(fmaxf(-MAX_SPIN, fminf(MAX_SPIN, spin.z)) * SPIN_SCALE);
+    }
+};
+
+static_assert(sizeof(BallState) <= 32, "BallState debe caber en 32 bytes");
+static_assert(std::is_trivially_copyable<BallState>::value, "BallState debe poder copiarse con memcpy");
+
+// Función para detectar y manejar colisión con la red.
+// Devuelve true si hay choque y guarda en outContact el punto de la pelota que
+// toca el plano de la red (en el borde, a la altura del centro)
+inline bool CheckNetCollision(BallState& ball, Vector3 position, Vector3& newPosition, float radius,
+                              float netZ, float floorY, const Court& court, Vector3& outContact) {
+    // Determinar la dirección del movimiento en Z
+    float deltaZ = newPosition.z - position.z;
+    if (std::abs(deltaZ) <= 0.001f) {  // No hay movimiento significativo en Z
+        return false;
+    }
+    
+    // Calcular el borde de la pelota que está más cerca de la red
+    // Si se mueve hacia adelante (deltaZ > 0), el borde delantero es position.z + radius
+    // Si se mueve hacia atrás (deltaZ < 0), el borde trasero es position.z - radius
+    float previousEdgeZ = position.z + (deltaZ > 0 ? radius : -radius);
+    float newEdgeZ = newPosition.z + (deltaZ > 0 ? radius : -radius);
+    
+    // Verificar si el borde de la pelota está cruzando o cruzó la red
+    bool previousWasBeforeNet = previousEdgeZ < netZ;
+    bool newIsAfterNet = newEdgeZ >= netZ;
+    bool previousWasAfterNet = previousEdgeZ > netZ;
+    bool newIsBeforeNet = newEdgeZ < netZ;
+    
+    // Si el borde de la pelota cruzó la red
+    if (!((previousWasBeforeNet && newIsAfterNet) || (previousWasAfterNet && newIsBeforeNet))) {
+        return false;
+    }
+    
+    // Verificar si la altura de la pelota es menor que la altura de la red
+    // Usar la posición intermedia (en la red) para la verificación
+    float t = (netZ - previousEdgeZ) / (newEdgeZ - previousEdgeZ);
+    float collisionX = position.x + (newPosition.x - position.x) * t;
+    float collisionY = position.y + (newPosition.y - position.y) * t;
+    
+    float netHeight = court.GetNetHeightAtX(collisionX);
+    float ballHeightAboveFloor = collisionY - floorY;
+    
+    // Si cualquier parte de la pelota está por debajo de la altura de la red
+    // (el punto más bajo de la pelota es ballHeightAboveFloor - radius)
+    if (ballHeightAboveFloor - radius >= netHeight) {
+        return false;
+    }
+    outContact = {collisionX, collisionY, netZ};
+    
+    // Hay colisión: reposicionar la pelota del lado correcto de la red
+    // Colocar el borde exterior de la pelota justo antes/después de la red
+    if (previousWasBeforeNet) {
+        // Venía desde antes de la red, dejarla justo antes
+        newPosition.z = netZ - radius - 0.1f; // Pequeño margen para evitar que quede exactamente en la red
+    } else {
+        // Venía desde después de la red, dejarla justo después
+        newPosition.z = netZ + radius + 0.1f; // Pequeño margen
+    }
+    
+    // Detener el movimiento horizontal y dejar que caiga por gravedad
+    ball.body.velocity[0] = 0.0f;
+    ball.body.velocity[2] = 0.0f;
+    ball.spinX = 0;
+    ball.spinZ = 0;
+    return true;
+}
+
+// Avanza una pelota un paso: gravedad, colisión con la red y rebote con el suelo.
+// Devuelve true si la pelota ha tocado el suelo en este paso.
+// Si se pasa una cola, emite los eventos del paso en orden (red, bote, parada)
+// con el instante time (fin del paso) y el origen source.
+inline bool StepBall(BallState& ball, float deltaTime, float radius, float floorY, float netZ, const Court& court,
+                     SimEventQueue* events = nullptr, float time = 0.0f, uint32_t source = 0) {
+    if (!ball.body.isMoving) return false;
+
+    const ProfilePhysics physics{court.GetPhysics()};
+
+    // Aplicar gravedad y calcular nueva posición
+    Vector3 previousPosition = ball.GetPosition();
+    Physics::Integrate<3>(ball.body, deltaTime, physics);
+    Vector3 newPosition = ball.GetPosition();
+
+    // Detectar colisión con la red ANTES de actualizar la posición
+    Vector3 netContact = {0.0f, 0.0f, 0.0f};
+    bool hitNet = CheckNetCollision(ball, previousPosition, newPosition, radius, netZ, floorY, court, netContact);
+    ball.SetPosition(newPosition);
+
+    // Rebote con el suelo: spin lateral, fricción horizontal y parada si el rebote es pequeño
+    const float impactSpeed = -ball.body.velocity[1];
+    const float spinImpulse[3] = {ball.spinX / BallState::SPIN_SCALE, 0.0f, ball.spinZ / BallState::SPIN_SCALE};
+    bool touchedFloor = Physics::ResolveSurface<3>(ball.body, floorY + radius, physics, spinImpulse);
+
+    if (events) {
+        Vector3 position = ball.GetPosition();
+        if (hitNet) {
+            events->Push(SimEventType::NetHit, source, time, netContact, netContact.y - floorY);
+        } else if ((previousPosition.z - netZ) * (position.z - netZ) < 0.0f) {
+            // Cruce del centro por el plano de la red: punto y margen interpolados en el cruce
+            float t = (netZ - previousPosition.z) / (position.z - previousPosition.z);
+            float x = previousPosition.x + (position.x - previousPosition.x) * t;
+            float y = previousPosition.y + (position.y - previousPosition.y) * t;
+            float clearance = (y - floorY - radius) - court.GetNetHeightAtX(x);
+            events->Push(SimEventType::NetCrossed, source, time, {x, y, netZ}, clearance);
+        }
+        if (touchedFloor) {
+            // Punto de contacto con el suelo, bajo el centro de la pelota
+            events->Push(SimEventType::Bounce, source, time, {position.x, floorY, position.z}, impactSpeed);
+        }
+        if (!ball.body.isMoving) {
+            events->Push(SimEventType::Stop, source, time, position);
+        }
+    }
+    return touchedFloor;
+}
+
+#endif // BALL_STATE_H
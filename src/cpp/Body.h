@@ -0,0 +1,71 @@
+#ifndef BODY_H
+#define BODY_H
+
+#include <cmath>
+
+// Cuerpo rígido genérico en N dimensiones (estado mínimo: posición, velocidad y si se mueve).
+//
+// El comportamiento físico lo define una política con:
+//   UP_AXIS              eje sobre el que actúan la gravedad y la superficie de contacto
+//   SURFACE_SIDE         +1 si el cuerpo está por encima de la superficie (suelo con Y hacia arriba),
+//                        -1 si está por debajo o a su izquierda (suelo en coordenadas de
+//                        pantalla, pared a la derecha)
+//   Gravity()            aceleración con signo sobre UP_AXIS
+//   Restitution()        fracción de velocidad que se conserva al rebotar
+//   Friction()           factor aplicado al resto de ejes en cada contacto
+//   StopVelocity()       por debajo de esta velocidad de rebote el cuerpo se detiene
+//
+// Políticas actuales: ProfilePhysics (PhysicsProfile.h, Body<3> de la pista, lee los
+// valores del perfil en tiempo de ejecución), ScreenFloorPhysics (Ball.h) y WallPhysics
+// (Rect.h), ambas Body<2>. UP_AXIS y SURFACE_SIDE son siempre constantes, así que el
+// bucle de ejes se desenrolla en cada especialización. Los lotes de pelotas 3D se
+// avanzan con BallPool::StepAll sobre un array contiguo.
+template <int N>
+struct Body {
+    float position[N];
+    float velocity[N];
+    bool isMoving;
+};
+
+namespace Physics {
+
+// Integración semi-implícita de Euler: primero la gravedad, luego la posición
+template <int N, typename Policy>
+inline void Integrate(Body<N>& body, float deltaTime, const Policy& policy) {
+    body.velocity[Policy::UP_AXIS] += policy.Gravity() * deltaTime;
+    for (int axis = 0; axis < N; axis++) {
+        body.position[axis] += body.velocity[axis] * deltaTime;
+    }
+}
+
+// Contacto con la superficie perpendicular a UP_AXIS situada en 'surface'.
+// 'impulse' (opcional, N componentes) se suma a los ejes tangenciales al rebotar.
+// Devuelve true si hubo contacto.
+template <int N, typename Policy>
+inline bool ResolveSurface(Body<N>& body, float surface, const Policy& policy, const float* impulse = nullptr) {
+    const int up = Policy::UP_AXIS;
+    if ((body.position[up] - surface) * Policy::SURFACE_SIDE > 0.0f) {
+        return false;
+    }
+
+    body.position[up] = surface;
+    body.velocity[up] = -body.velocity[up] * policy.Restitution();
+
+    for (int axis = 0; axis < N; axis++) {
+        if (axis == up) continue;
+        body.velocity[axis] = body.velocity[axis] * policy.Friction() + (impulse ? impulse[axis] : 0.0f);
+    }
+
+    // Parar el cuerpo si el rebote es demasiado pequeño
+    if (std::abs(body.velocity[up]) < policy.StopVelocity()) {
+        for (int axis = 0; axis < N; axis++) {
+            body.velocity[axis] = 0.0f;
+        }
+        body.isMoving = false;
+    }
+    return true;
+}
+
+} // namespace Physics
+
+#endif // BODY_H
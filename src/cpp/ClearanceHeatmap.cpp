@@ -0,0 +1,53 @@
+#include "ClearanceHeatmap.h"
+#include <cmath>
+#include <vector>
+
+// Pasos de simulación entre consultas del reloj (un paso de fila son 91 StepBall)
+static const int STEPS_PER_YIELD_CHECK = 8;
+
+void ClearanceHeatmapJob::StartRow() {
+    const int columns = GetColumns();
+    rowValues.assign(columns, NAN);
+
+    // Toda la fila se simula a la vez en la arena: un golpe por hueco
+    ShotParams shot = baseShot;
+    shot.elevationDeg = ShotSweep::GetElevation(row);
+    pool.Clear();
+    for (int i = 0; i < columns; i++) {
+        shot.angleDeg = ShotSweep::GetAngle(i);
+        Vector3 velocity = CalculateVelocityFromAngle(shot.speed, shot.angleDeg, shot.elevationDeg);
+        pool.Allocate(BallState::Make(shot.origin, velocity, shot.spin));
+    }
+    rowTime = 0.0f;
+    rowMoving = columns;
+    rowStarted = true;
+}
+
+bool ClearanceHeatmapJob::RunSlice(JobContext& context) {
+    if (!rowStarted) {
+        StartRow();
+    }
+
+    // Las pelotas que se detienen antes de llegar a la red dejan de contar solas;
+    // las que llegan se liberan al leer su evento de red
+    int steps = 0;
+    while (rowMoving > 0 && rowTime < MAX_SIMULATION_TIME) {
+        if (++steps % STEPS_PER_YIELD_CHECK == 0 && context.ShouldYield()) {
+            return false;  // El siguiente trozo continúa la fila (o el planificador la cancela)
+        }
+        events.Clear();
+        rowTime += SIMULATION_STEP;
+        rowMoving = pool.StepAll(SIMULATION_STEP, ballRadius, court, &events, rowTime);
+        for (const SimEvent& event : events) {
+            if (std::isnan(rowValues[event.source]) && GetNetClearance(event, court, ballRadius, rowValues[event.source])) {
+                if (pool[event.source].body.isMoving) rowMoving--;
+                pool.Release(event.source);
+            }
+        }
+    }
+
+    row++;
+    rowStarted = false;
+    context.PublishPartial((row - 1) * GetColumns(), std::move(rowValues), (float)row / GetRows());
+    return row >= GetRows();
+}
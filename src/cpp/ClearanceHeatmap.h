@@ -0,0 +1,45 @@
+#ifndef CLEARANCE_HEATMAP_H
+#define CLEARANCE_HEATMAP_H
+
+#include "JobScheduler.h"
+#include "TrajectoryCache.h"
+#include "BallPool.h"
+#include "ShotSweep.h"
+#include <vector>
+
+// Barrido de ángulo horizontal × elevación que calcula el margen sobre la red
+// de cada golpe. Cada fila (una elevación) se publica como resultado parcial al
+// terminarla: values[i] = margen del ángulo i (NaN si no llega a la red).
+// Sin hilos, una fila puede repartirse entre varios trozos: el estado de la
+// simulación de la fila se guarda y el siguiente trozo sigue en el mismo paso.
+// El resultado completo es una matriz de GetRows() × GetColumns() en orden de filas.
+class ClearanceHeatmapJob : public Job {
+private:
+    ShotParams baseShot;        // Origen, velocidad y spin comunes a todo el barrido
+    Court court;                // Copia: el trabajo no comparte estado con el hilo principal
+    float ballRadius;
+    BallPool pool;              // Una pelota por columna, reutilizada en cada fila
+    SimEventQueue events;       // Eventos de un paso de toda la fila
+    int row = 0;
+
+    // Fila en curso (se conserva entre trozos)
+    bool rowStarted = false;
+    std::vector<float> rowValues;
+    float rowTime = 0.0f;       // Tiempo simulado de la fila
+    uint32_t rowMoving = 0;     // Pelotas que aún no han llegado a la red ni se han parado
+
+    void StartRow();
+
+public:
+    // Columnas = ángulos y filas = elevaciones de ShotSweep
+    static constexpr int GetColumns() { return ShotSweep::GetAngleCount(); }
+    static constexpr int GetRows() { return ShotSweep::GetElevationCount(); }
+
+    ClearanceHeatmapJob(const ShotParams& baseShot, const Court& court, float ballRadius)
+        : baseShot(baseShot), court(court), ballRadius(ballRadius), pool(GetColumns()),
+          events(GetColumns() * 4) {}  // Como mucho red, bote y parada por pelota y paso
+
+    bool RunSlice(JobContext& context) override;
+};
+
+#endif // CLEARANCE_HEATMAP_H
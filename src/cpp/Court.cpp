@@ -164,7 +164,7 @@ void Court::DrawNetBand() const {
     float centerY = floorY + netHeightAtCenter;
     
     // Dibujar segmentos pequeños para la línea izquierda
-    const int segments = 50;
+    const int segments = detail.bandSegments;
     float leftSegmentLength = centerX - postLeftX;
     for (int i = 0; i < segments; i++) {
         float t = (float)i / segments;
@@ -202,8 +202,8 @@ void Court::DrawNetMesh() const {
     float netWidth = postRightX - postLeftX;  // Ancho total de la red (incluyendo postes)
     
     // Número de líneas verticales y horizontales para crear la malla
-    const int verticalLines = 40;   // Líneas verticales (de arriba a abajo)
-    const int horizontalLines = 15; // Líneas horizontales (de lado a lado)
+    const int verticalLines = detail.netVerticalLines;     // Líneas verticales (de arriba a abajo)
+    const int horizontalLines = detail.netHorizontalLines; // Líneas horizontales (de lado a lado)
     
     // Dibujar líneas verticales siguiendo la forma de dos líneas rectas, desde poste a poste
     for (int i = 0; i <= verticalLines; i++) {
@@ -217,7 +217,7 @@ void Court::DrawNetMesh() const {
     
     // Dibujar líneas horizontales siguiendo la forma de dos líneas rectas, desde poste a poste
     // Dividimos en segmentos para que sigan la forma
-    const int horizontalSegments = 50;
+    const int horizontalSegments = detail.netHorizontalSegments;
     for (int i = 0; i <= horizontalLines; i++) {
         // Altura normalizada (0 = suelo, 1 = altura máxima en el centro)
         float heightRatio = (float)i / horizontalLines;
@@ -0,0 +1,68 @@
+#include "InputBridge.h"
+
+namespace {
+    const int MAX_KEYS = 512;               // Los códigos de tecla de raylib son menores que 512
+    const int MAX_MOUSE_BUTTONS = 8;
+
+    bool forwarding = false;
+    Vector2 mousePosition = {0.0f, 0.0f};
+    bool mouseButtons[MAX_MOUSE_BUTTONS] = {};
+    bool keys[MAX_KEYS] = {};
+    float wheelMove = 0.0f;
+}
+
+namespace Input {
+    void SetForwarding(bool enabled) {
+        forwarding = enabled;
+        // Empezar sin teclas ni botones pulsados
+        for (bool& button : mouseButtons) button = false;
+        for (bool& key : keys) key = false;
+        wheelMove = 0.0f;
+    }
+
+    bool IsForwarding() {
+        return forwarding;
+    }
+
+    void ForwardMouseMove(float x, float y) {
+        mousePosition = {x, y};
+    }
+
+    void ForwardMouseButton(int button, bool down) {
+        if (button >= 0 && button < MAX_MOUSE_BUTTONS) {
+            mouseButtons[button] = down;
+        }
+    }
+
+    void ForwardMouseWheel(float delta) {
+        wheelMove += delta;
+    }
+
+    void ForwardKey(int key, bool down) {
+        if (key >= 0 && key < MAX_KEYS) {
+            keys[key] = down;
+        }
+    }
+
+    Vector2 GetMousePosition() {
+        return forwarding ? mousePosition : ::GetMousePosition();
+    }
+
+    bool IsMouseButtonDown(int button) {
+        if (!forwarding) return ::IsMouseButtonDown(button);
+        return button >= 0 && button < MAX_MOUSE_BUTTONS && mouseButtons[button];
+    }
+
+    bool IsKeyDown(int key) {
+        if (!forwarding) return ::IsKeyDown(key);
+        return key >= 0 && key < MAX_KEYS && keys[key];
+    }
+
+    float GetMouseWheelMove() {
+        return forwarding ? wheelMove : ::GetMouseWheelMove();
+    }
+
+    void EndFrame() {
+        wheelMove = 0.0f;
+    }
+}
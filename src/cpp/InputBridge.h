@@ -0,0 +1,29 @@
+#ifndef INPUT_BRIDGE_H
+#define INPUT_BRIDGE_H
+
+#include "raylib.h"
+
+// Entrada de ratón y teclado para los controles de la cámara.
+// En el modo normal se lee directamente de raylib. Cuando el módulo se ejecuta
+// en un worker con OffscreenCanvas no llegan eventos del DOM, así que el hilo
+// principal los reenvía (Forward*) y estas funciones devuelven ese estado.
+namespace Input {
+    void SetForwarding(bool enabled);
+    bool IsForwarding();
+
+    // Eventos reenviados desde JS (coordenadas en píxeles del canvas y códigos de raylib)
+    void ForwardMouseMove(float x, float y);
+    void ForwardMouseButton(int button, bool down);
+    void ForwardMouseWheel(float delta);
+    void ForwardKey(int key, bool down);
+
+    Vector2 GetMousePosition();
+    bool IsMouseButtonDown(int button);
+    bool IsKeyDown(int key);
+    float GetMouseWheelMove();      // Movimiento acumulado desde el último EndFrame()
+
+    // Llamar al final de cada frame: descarta la rueda ya consumida
+    void EndFrame();
+}
+
+#endif // INPUT_BRIDGE_H
@@ -0,0 +1,225 @@
+#include "JobScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+// Número de hilos de fondo en WebAssembly: debe coincidir con PTHREAD_POOL_SIZE
+#ifndef TENNIS_JOB_WORKERS
+    #define TENNIS_JOB_WORKERS 2
+#endif
+
+void JobContext::ReportProgress(float progress) {
+    scheduler.Post({id, JobUpdate::Progress, progress, 0, {}});
+}
+
+void JobContext::PublishPartial(int32_t offset, std::vector<float> values, float progress) {
+    scheduler.Post({id, JobUpdate::Partial, progress, offset, std::move(values)});
+}
+
+JobScheduler::JobScheduler(int workerCount) {
+#if TENNIS_JOB_THREADS
+    if (workerCount <= 0) {
+    #ifdef __EMSCRIPTEN__
+        workerCount = TENNIS_JOB_WORKERS;
+    #else
+        // Dejar un núcleo libre para el render
+        int cores = (int)std::thread::hardware_concurrency();
+        workerCount = std::max(1, std::min(cores - 1, 4));
+    #endif
+    }
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobScheduler::WorkerLoop, this);
+    }
+#else
+    (void)workerCount;
+#endif
+}
+
+JobScheduler::~JobScheduler() {
+#if TENNIS_JOB_THREADS
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        for (auto& record : queue) record->cancelled = true;
+        for (auto& record : running) record->cancelled = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+#endif
+}
+
+JobId JobScheduler::Submit(std::unique_ptr<Job> job, int priority) {
+    auto record = std::make_shared<Record>();
+    record->priority = priority;
+    record->job = std::move(job);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        record->id = nextId++;
+        queue.push_back(record);
+    }
+#if TENNIS_JOB_THREADS
+    wakeUp.notify_one();
+#endif
+    return record->id;
+}
+
+void JobScheduler::Cancel(JobId id) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Si aún no ha empezado (o está pausado), se elimina directamente de la cola
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if ((*it)->id == id) {
+            outbox.push_back({id, JobUpdate::Cancelled, (*it)->progress, 0, {}});
+            queue.erase(it);
+            return;
+        }
+    }
+
+    // Si se está ejecutando, el hilo lo detendrá al terminar el trozo actual
+    for (auto& record : running) {
+        if (record->id == id) {
+            record->cancelled = true;
+            return;
+        }
+    }
+}
+
+std::shared_ptr<JobScheduler::Record> JobScheduler::PopHighestPriority() {
+    if (queue.empty()) {
+        return nullptr;
+    }
+    // A igual prioridad, el más antiguo primero
+    auto best = queue.begin();
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if ((*it)->priority > (*best)->priority ||
+            ((*it)->priority == (*best)->priority && (*it)->id < (*best)->id)) {
+            best = it;
+        }
+    }
+    std::shared_ptr<Record> record = *best;
+    queue.erase(best);
+    return record;
+}
+
+bool JobScheduler::HasHigherPriorityThan(int priority) {
+    for (auto& record : queue) {
+        if (record->priority > priority) return true;
+    }
+    return false;
+}
+
+bool JobScheduler::RunSlice(const std::shared_ptr<Record>& record, JobContext::Clock::time_point deadline) {
+    if (record->cancelled) {
+        Post({record->id, JobUpdate::Cancelled, record->progress, 0, {}});
+        return true;
+    }
+
+    JobContext context(*this, record->id, record->cancelled, record->failed, deadline);
+    bool finished = record->job->RunSlice(context);
+
+    if (record->cancelled) {
+        Post({record->id, JobUpdate::Cancelled, record->progress, 0, {}});
+        return true;
+    }
+    if (record->failed) {
+        Post({record->id, JobUpdate::Failed, record->progress, 0, {}});
+        return true;
+    }
+    if (finished) {
+        Post({record->id, JobUpdate::Done, 1.0f, 0, {}});
+        return true;
+    }
+    return false;
+}
+
+void JobScheduler::Post(JobUpdate update) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Recordar el último progreso del trabajo (para notificar cancelaciones)
+    for (auto& record : running) {
+        if (record->id == update.id) {
+            record->progress = update.progress;
+            break;
+        }
+    }
+
+    // Las notificaciones de progreso sin datos se fusionan: solo interesa la última
+    if (update.type == JobUpdate::Progress) {
+        for (JobUpdate& pending : outbox) {
+            if (pending.id == update.id && pending.type == JobUpdate::Progress) {
+                pending.progress = update.progress;
+                return;
+            }
+        }
+    }
+    outbox.push_back(std::move(update));
+}
+
+#if TENNIS_JOB_THREADS
+void JobScheduler::WorkerLoop() {
+    for (;;) {
+        std::shared_ptr<Record> record;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            record = PopHighestPriority();
+            running.push_back(record);
+        }
+
+        for (;;) {
+            // En un hilo de fondo no hay presupuesto: el trozo solo se corta al cancelar
+            bool finished = RunSlice(record, JobContext::Clock::time_point::max());
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (finished || stopping) {
+                running.erase(std::find(running.begin(), running.end(), record));
+                break;
+            }
+            // Ceder el hilo si ha llegado un trabajo más prioritario
+            if (HasHigherPriorityThan(record->priority)) {
+                running.erase(std::find(running.begin(), running.end(), record));
+                queue.push_back(record);
+                break;
+            }
+        }
+    }
+}
+
+void JobScheduler::Pump(double budgetMs) {
+    (void)budgetMs;
+}
+#else
+void JobScheduler::Pump(double budgetMs) {
+    using Clock = JobContext::Clock;
+    Clock::time_point deadline = Clock::now() + std::chrono::microseconds((int64_t)(budgetMs * 1000.0));
+
+    while (Clock::now() < deadline) {
+        std::shared_ptr<Record> record;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            record = PopHighestPriority();
+            if (!record) return;
+            running.push_back(record);
+        }
+
+        // El trabajo recibe el mismo límite para cortar su trozo a tiempo
+        bool finished = RunSlice(record, deadline);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        running.erase(std::find(running.begin(), running.end(), record));
+        if (!finished) {
+            // Vuelve a la cola: el siguiente trozo lo elige de nuevo por prioridad
+            queue.push_back(record);
+        }
+    }
+}
+#endif
+
+void JobScheduler::Drain(std::vector<JobUpdate>& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    out.clear();
+    out.swap(outbox);
+}
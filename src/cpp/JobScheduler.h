@@ -0,0 +1,142 @@
+#ifndef JOB_SCHEDULER_H
+#define JOB_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Con hilos (nativo, o WebAssembly compilado con -pthread) los trabajos se
+// ejecutan en hilos de fondo. Sin hilos, Pump() ejecuta trozos en el hilo
+// principal con un presupuesto de tiempo por frame para no bloquear el render.
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+    #define TENNIS_JOB_THREADS 1
+    #include <condition_variable>
+    #include <thread>
+#else
+    #define TENNIS_JOB_THREADS 0
+#endif
+
+typedef int32_t JobId;
+
+class JobContext;
+
+// Trabajo de análisis dividido en trozos pequeños.
+// Entre trozo y trozo el planificador comprueba la cancelación y las prioridades.
+// Un trozo largo debe consultar JobContext::ShouldYield() y devolver false en
+// cuanto sea true: el siguiente trozo continúa donde lo dejó.
+class Job {
+public:
+    virtual ~Job() = default;
+
+    // Ejecuta un trozo de trabajo. Devuelve true cuando el trabajo ha terminado.
+    virtual bool RunSlice(JobContext& context) = 0;
+};
+
+// Notificación de un trabajo hacia el hilo principal
+struct JobUpdate {
+    enum Type : int32_t {
+        Progress = 0,   // Solo progreso
+        Partial = 1,    // Resultados parciales en 'values' a partir de 'offset'
+        Done = 2,
+        Cancelled = 3,
+        Failed = 4      // El trabajo no pudo completarse (ver JobContext::Fail)
+    };
+
+    JobId id;
+    Type type;
+    float progress;             // 0..1
+    int32_t offset;
+    std::vector<float> values;
+};
+
+class JobScheduler;
+
+// Interfaz que ve un trabajo mientras se ejecuta
+class JobContext {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    JobScheduler& scheduler;
+    JobId id;
+    const std::atomic<bool>& cancelled;
+    bool& failed;
+    Clock::time_point deadline;     // Fin del presupuesto del frame (sin hilos); max() con hilos
+
+public:
+    JobContext(JobScheduler& scheduler, JobId id, const std::atomic<bool>& cancelled, bool& failed,
+               Clock::time_point deadline)
+        : scheduler(scheduler), id(id), cancelled(cancelled), failed(failed), deadline(deadline) {}
+
+    bool IsCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    // true si el trozo debe terminar ya: cancelado o agotado el presupuesto del frame
+    bool ShouldYield() const {
+        return IsCancelled() || (deadline != Clock::time_point::max() && Clock::now() >= deadline);
+    }
+    // Marca el trabajo como fallido: RunSlice debe devolver true y se notifica
+    // Failed en lugar de Done
+    void Fail() { failed = true; }
+
+    void ReportProgress(float progress);
+    void PublishPartial(int32_t offset, std::vector<float> values, float progress);
+};
+
+class JobScheduler {
+private:
+    struct Record {
+        JobId id;
+        int priority;
+        std::unique_ptr<Job> job;
+        std::atomic<bool> cancelled{false};
+        bool failed = false;                // Solo lo toca el hilo que ejecuta el trabajo
+        float progress = 0.0f;
+    };
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Record>> queue;     // Pendientes (y pausados por prioridad)
+    std::vector<std::shared_ptr<Record>> running;   // En ejecución en algún hilo
+    std::vector<JobUpdate> outbox;                  // Notificaciones pendientes de Drain()
+    JobId nextId = 1;
+
+#if TENNIS_JOB_THREADS
+    std::condition_variable wakeUp;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+
+    void WorkerLoop();
+#endif
+
+    std::shared_ptr<Record> PopHighestPriority();   // Requiere el mutex
+    bool HasHigherPriorityThan(int priority);       // Requiere el mutex
+    // Ejecuta un trozo del trabajo. Devuelve true si el trabajo ha terminado o se ha cancelado.
+    bool RunSlice(const std::shared_ptr<Record>& record, JobContext::Clock::time_point deadline);
+    void Post(JobUpdate update);
+
+    friend class JobContext;
+
+public:
+    // workerCount solo se usa con hilos; 0 = elegir según el hardware
+    explicit JobScheduler(int workerCount = 0);
+    ~JobScheduler();
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    // Encola un trabajo. Mayor prioridad = se ejecuta antes
+    JobId Submit(std::unique_ptr<Job> job, int priority = 0);
+
+    // Pide cancelar un trabajo. Se detiene al terminar el trozo en curso
+    void Cancel(JobId id);
+
+    // Sin hilos, ejecuta trozos durante como mucho budgetMs. Con hilos no hace nada.
+    void Pump(double budgetMs);
+
+    // Mueve a 'out' las notificaciones acumuladas (llamar desde el hilo principal)
+    void Drain(std::vector<JobUpdate>& out);
+};
+
+#endif // JOB_SCHEDULER_H
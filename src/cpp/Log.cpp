@@ -0,0 +1,65 @@
+#include "Log.h"
+#include <cstdio>
+
+#ifdef PLATFORM_WEB
+    #include <emscripten/emscripten.h>
+#endif
+
+#ifdef PLATFORM_WEB
+// Vuelca un tramo contiguo del buffer circular a la consola del navegador
+EM_JS_DEPS(tennis_log, "$UTF8ToString");
+EM_JS(void, tennis_log_flush_js, (const void* records, int count, int dropped), {
+    const RECORD_SIZE = 28;
+    const methods = ['debug', 'log', 'warn', 'error'];
+    for (let i = 0; i < count; i++) {
+        const base = records + i * RECORD_SIZE;
+        const message = UTF8ToString(HEAPU32[base >> 2]);
+        const level = HEAP32[(base + 4) >> 2];
+        const fieldCount = HEAP32[(base + 8) >> 2];
+        const fields = [];
+        for (let f = 0; f < fieldCount; f++) {
+            fields.push(HEAPF32[(base + 12 + f * 4) >> 2]);
+        }
+        console[methods[level] || 'log']('[WASM]', message, ...fields);
+    }
+    if (dropped > 0) {
+        console.warn('[WASM] ' + dropped + ' registros de log descartados (buffer lleno)');
+    }
+});
+#endif
+
+namespace Log {
+
+// Envía todos los registros pendientes. Se llama una vez por frame.
+void Flush() {
+    Ring& ring = GetRing();
+    RingLock lock(ring);
+    if (ring.count == 0 && ring.dropped == 0) {
+        return;
+    }
+#ifdef PLATFORM_WEB
+    // El buffer es circular: como mucho hay dos tramos contiguos
+    uint32_t firstSpan = RING_CAPACITY - ring.head;
+    if (firstSpan > ring.count) firstSpan = ring.count;
+    tennis_log_flush_js(&ring.records[ring.head], (int)firstSpan, 0);
+    tennis_log_flush_js(&ring.records[0], (int)(ring.count - firstSpan), (int)ring.dropped);
+#else
+    static const char* const LEVEL_NAMES[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+    for (uint32_t i = 0; i < ring.count; i++) {
+        const Record& r = ring.records[(ring.head + i) % RING_CAPACITY];
+        printf("[%s] %s", LEVEL_NAMES[r.level], r.message);
+        for (int f = 0; f < r.fieldCount; f++) {
+            printf(" %g", r.fields[f]);
+        }
+        printf("\n");
+    }
+    if (ring.dropped > 0) {
+        printf("[WARN] %u registros de log descartados (buffer lleno)\n", ring.dropped);
+    }
+#endif
+    ring.head = (ring.head + ring.count) % RING_CAPACITY;
+    ring.count = 0;
+    ring.dropped = 0;
+}
+
+} // namespace Log
@@ -0,0 +1,133 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <cstdint>
+
+// Sistema de logging estructurado de bajo coste.
+//
+// Cada registro lleva un nivel, un mensaje estático (literal de cadena, nunca
+// se copia ni se formatea en C++) y hasta LOG_MAX_FIELDS campos numéricos.
+// Los registros se guardan en un buffer circular preasignado y se envían a JS
+// en un único lote por frame con Log::Flush(), que lee el buffer directamente
+// de la memoria del módulo. No hay eval de JS ni problemas con comillas.
+//
+// Los niveles por debajo de TENNIS_LOG_LEVEL se eliminan en tiempo de
+// compilación: las macros se expanden a ((void)0) y no evalúan sus argumentos.
+// Por ejemplo, compilar con -DTENNIS_LOG_LEVEL=3 deja solo los errores.
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE  4
+
+#ifndef TENNIS_LOG_LEVEL
+    #ifdef NDEBUG
+        #define TENNIS_LOG_LEVEL LOG_LEVEL_INFO
+    #else
+        #define TENNIS_LOG_LEVEL LOG_LEVEL_DEBUG
+    #endif
+#endif
+
+#define LOG_MAX_FIELDS 4
+
+namespace Log {
+
+// Registro de log. El layout es fijo porque JS lo lee directamente de HEAP32/HEAPF32
+struct Record {
+    const char* message;            // Literal de cadena (vida estática)
+    int32_t level;
+    int32_t fieldCount;
+    float fields[LOG_MAX_FIELDS];
+};
+
+#ifdef __EMSCRIPTEN__
+static_assert(sizeof(Record) == 28, "El layout de Log::Record debe coincidir con Log::Flush en JS");
+#endif
+
+const int RING_CAPACITY = 256;  // Registros que caben entre dos flushes
+
+struct Ring {
+    Record records[RING_CAPACITY];
+    uint32_t head = 0;      // Índice del registro más antiguo
+    uint32_t count = 0;     // Registros pendientes
+    uint32_t dropped = 0;   // Registros descartados por desbordamiento desde el último flush
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;  // Los trabajos de fondo también registran mensajes
+};
+
+// Bloqueo mínimo del buffer: las secciones protegidas son muy cortas
+class RingLock {
+private:
+    std::atomic_flag& flag;
+
+public:
+    explicit RingLock(Ring& ring) : flag(ring.busy) {
+        while (flag.test_and_set(std::memory_order_acquire)) {}
+    }
+    ~RingLock() { flag.clear(std::memory_order_release); }
+};
+
+inline Ring& GetRing() {
+    static Ring ring;
+    return ring;
+}
+
+inline void Push(int level, const char* message, int fieldCount, const float* fields) {
+    Ring& ring = GetRing();
+    RingLock lock(ring);
+    if (ring.count == RING_CAPACITY) {
+        // Buffer lleno: sobrescribir el registro más antiguo, nunca reservar memoria
+        ring.head = (ring.head + 1) % RING_CAPACITY;
+        ring.count--;
+        ring.dropped++;
+    }
+    Record& r = ring.records[(ring.head + ring.count) % RING_CAPACITY];
+    r.message = message;
+    r.level = level;
+    r.fieldCount = fieldCount;
+    for (int i = 0; i < LOG_MAX_FIELDS; i++) {
+        r.fields[i] = fields[i];
+    }
+    ring.count++;
+}
+
+// Punto de entrada de las macros LOG_*: convierte los campos numéricos a float
+template <typename... Fields>
+inline void Write(int level, const char* message, Fields... fields) {
+    static_assert(sizeof...(Fields) <= LOG_MAX_FIELDS, "Demasiados campos en el registro de log");
+    const float values[LOG_MAX_FIELDS] = {static_cast<float>(fields)...};
+    Push(level, message, (int)sizeof...(Fields), values);
+}
+
+// Envía todos los registros pendientes. Se llama una vez por frame.
+void Flush();
+
+} // namespace Log
+
+// Macros de logging. Los niveles desactivados no generan código
+#if TENNIS_LOG_LEVEL <= LOG_LEVEL_DEBUG
+    #define LOG_DEBUG(...) Log::Write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+    #define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if TENNIS_LOG_LEVEL <= LOG_LEVEL_INFO
+    #define LOG_INFO(...) Log::Write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+    #define LOG_INFO(...) ((void)0)
+#endif
+
+#if TENNIS_LOG_LEVEL <= LOG_LEVEL_WARN
+    #define LOG_WARN(...) Log::Write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+    #define LOG_WARN(...) ((void)0)
+#endif
+
+#if TENNIS_LOG_LEVEL <= LOG_LEVEL_ERROR
+    #define LOG_ERROR(...) Log::Write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+    #define LOG_ERROR(...) ((void)0)
+#endif
+
+#endif // LOG_H
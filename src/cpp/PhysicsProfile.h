@@ -0,0 +1,25 @@
+#ifndef PHYSICS_PROFILE_H
+#define PHYSICS_PROFILE_H
+
+// Parámetros físicos de las pelotas de una pista. Cada pista tiene un perfil y
+// todas sus pelotas lo comparten por referencia en lugar de llevar su propia copia.
+struct PhysicsProfile {
+    float gravity = -980.0f;       // Gravedad en px/s^2 (sobre Y)
+    float restitution = 0.7f;      // Rebote vertical
+    float frictionXZ = 0.98f;      // Reducción de velocidad horizontal al rebotar
+    float minVelocity = 20.0f;     // Umbral para detener rebote
+};
+
+// Política de Body<3> que lee los parámetros de un perfil compartido
+struct ProfilePhysics {
+    static constexpr int UP_AXIS = 1;
+    static constexpr float SURFACE_SIDE = 1.0f;
+    const PhysicsProfile& profile;
+
+    float Gravity() const { return profile.gravity; }
+    float Restitution() const { return profile.restitution; }
+    float Friction() const { return profile.frictionXZ; }
+    float StopVelocity() const { return profile.minVelocity; }
+};
+
+#endif // PHYSICS_PROFILE_H
@@ -0,0 +1,86 @@
+#include "QualityGovernor.h"
+
+// El último nivel reproduce exactamente la carga visual original
+static const QualitySettings QUALITY_LEVELS[QualityGovernor::LEVEL_COUNT] = {
+    // trail, verticales, horizontales, segmentos, cinta, anillos, gajos, escala
+    {  4, 12,  6,  2,  2,  8,  8, 0.5f },
+    { 10, 20,  8,  4, 12, 10, 10, 0.75f },
+    { 20, 30, 12, 10, 24, 12, 12, 1.0f },
+    { 30, 40, 15, 50, 50, 16, 16, 1.0f },
+};
+
+static const float AVERAGE_WEIGHT = 0.1f;        // Peso de cada frame en la media exponencial
+static const float MAX_SAMPLE_TIME = 0.1f;       // Los parones (pestaña oculta...) no cuentan más que esto
+static const float SLOW_FRAME_RATIO = 1.25f;     // Frame lento: media > 125 % del presupuesto
+static const float FAST_WORK_RATIO = 0.5f;       // Hay margen: trabajo < 50 % del presupuesto
+static const int FRAMES_TO_DOWNGRADE = 30;       // ~0,5 s seguidos lentos
+static const int FRAMES_TO_UPGRADE = 180;        // ~3 s seguidos con margen
+static const int COOLDOWN_FRAMES = 60;           // Tras un cambio, esperar a que la media se estabilice
+static const int UPGRADE_PROBATION_FRAMES = 600; // ~10 s sin bajar confirman una subida
+static const int MAX_UPGRADE_FRAMES = 18000;     // La espera tras subidas fallidas no pasa de ~5 min
+
+QualityGovernor::QualityGovernor(int targetFps, int initialLevel)
+    : level(initialLevel), targetFrameTime(1.0f / (float)targetFps),
+      averageFrameTime(targetFrameTime), averageWorkTime(0.0f), upgradeFrames(FRAMES_TO_UPGRADE) {}
+
+bool QualityGovernor::Update(float frameTime, float workTime) {
+    if (frameTime > MAX_SAMPLE_TIME) frameTime = MAX_SAMPLE_TIME;
+    if (workTime > MAX_SAMPLE_TIME) workTime = MAX_SAMPLE_TIME;
+    averageFrameTime += (frameTime - averageFrameTime) * AVERAGE_WEIGHT;
+    averageWorkTime += (workTime - averageWorkTime) * AVERAGE_WEIGHT;
+
+    if (!automatic) return false;
+
+    // Una subida que aguanta el periodo de prueba devuelve la espera a su valor inicial
+    if (framesSinceUpgrade >= 0 && ++framesSinceUpgrade > UPGRADE_PROBATION_FRAMES) {
+        framesSinceUpgrade = -1;
+        upgradeFrames = FRAMES_TO_UPGRADE;
+    }
+    if (cooldownFrames > 0) {
+        cooldownFrames--;
+        return false;
+    }
+
+    bool slow = averageFrameTime > targetFrameTime * SLOW_FRAME_RATIO;
+    bool fast = !slow && averageWorkTime < targetFrameTime * FAST_WORK_RATIO;
+    slowFrames = slow ? slowFrames + 1 : 0;
+    fastFrames = fast ? fastFrames + 1 : 0;
+
+    int newLevel = level;
+    if (slowFrames >= FRAMES_TO_DOWNGRADE && level > 0) {
+        newLevel = level - 1;
+        if (framesSinceUpgrade >= 0) {
+            // Subida fallida: esperar el doble antes de volver a intentarlo
+            upgradeFrames = upgradeFrames * 2 < MAX_UPGRADE_FRAMES ? upgradeFrames * 2 : MAX_UPGRADE_FRAMES;
+            framesSinceUpgrade = -1;
+        }
+    } else if (fastFrames >= upgradeFrames && level < LEVEL_COUNT - 1) {
+        newLevel = level + 1;
+        framesSinceUpgrade = 0;
+    }
+    if (newLevel == level) return false;
+
+    level = newLevel;
+    slowFrames = 0;
+    fastFrames = 0;
+    cooldownFrames = COOLDOWN_FRAMES;
+    return true;
+}
+
+void QualityGovernor::SetLevel(int newLevel) {
+    slowFrames = 0;
+    fastFrames = 0;
+    cooldownFrames = COOLDOWN_FRAMES;
+    upgradeFrames = FRAMES_TO_UPGRADE;
+    framesSinceUpgrade = -1;
+    if (newLevel < 0) {
+        automatic = true;
+        return;
+    }
+    automatic = false;
+    level = newLevel < LEVEL_COUNT ? newLevel : LEVEL_COUNT - 1;
+}
+
+const QualitySettings& QualityGovernor::GetSettings() const {
+    return QUALITY_LEVELS[level];
+}
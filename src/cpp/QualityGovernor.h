@@ -0,0 +1,53 @@
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+// Parámetros visuales de un nivel de calidad
+struct QualitySettings {
+    int trailPoints;            // Puntos de la estela que se dibujan
+    int netVerticalLines;       // Densidad de la malla de la red
+    int netHorizontalLines;
+    int netHorizontalSegments;  // Segmentos por línea horizontal (par: el vértice central queda exacto)
+    int bandSegments;           // Segmentos de cada mitad de la cinta
+    int sphereRings;            // Teselado de las esferas
+    int sphereSlices;
+    float renderScale;          // Resolución del render 3D respecto a la ventana
+};
+
+// Regulador de calidad: compara el tiempo de frame con el presupuesto del
+// objetivo de FPS y sube o baja de nivel con histéresis. Baja rápido cuando los
+// frames se pasan del presupuesto y sube despacio, solo cuando sobra tiempo de
+// trabajo de forma sostenida (con vsync el intervalo no baja de 1/fps aunque sobre).
+// El tiempo de trabajo es solo CPU: en la web el trabajo de la GPU no aparece, así
+// que una subida puede fallar enseguida. Cada subida fallida (bajada poco después
+// de subir) duplica la espera para volver a intentarlo.
+class QualityGovernor {
+private:
+    int level;
+    bool automatic = true;
+    float targetFrameTime;
+    float averageFrameTime;     // Media exponencial del intervalo entre frames
+    float averageWorkTime;      // Media exponencial del tiempo de update + dibujado
+    int slowFrames = 0;
+    int fastFrames = 0;
+    int cooldownFrames = 0;     // Frames sin cambios tras el último cambio de nivel
+    int upgradeFrames;          // Frames con margen necesarios para subir (crece con cada subida fallida)
+    int framesSinceUpgrade = -1; // Frames desde la última subida aún no confirmada (-1 = ninguna)
+
+public:
+    static const int LEVEL_COUNT = 4;  // 0 = mínima, LEVEL_COUNT - 1 = calidad original
+
+    explicit QualityGovernor(int targetFps, int initialLevel = LEVEL_COUNT - 1);
+
+    // Registra un frame (segundos). Devuelve true si el nivel ha cambiado.
+    bool Update(float frameTime, float workTime);
+
+    // Fija un nivel a mano (desactiva el modo automático); -1 vuelve al automático
+    void SetLevel(int newLevel);
+
+    int GetLevel() const { return level; }
+    bool IsAutomatic() const { return automatic; }
+    float GetAverageFrameTime() const { return averageFrameTime; }
+    const QualitySettings& GetSettings() const;
+};
+
+#endif // QUALITY_GOVERNOR_H
@@ -2,45 +2,54 @@
 #define RECT_H
 
 #include "raylib.h"
+#include "Body.h"
+
+// Política de Body<2> para una pared a la derecha: sin gravedad y el cuerpo se para al tocarla
+struct WallPhysics {
+    static constexpr int UP_AXIS = 0;
+    static constexpr float SURFACE_SIDE = -1.0f;
+
+    float Gravity() const { return 0.0f; }
+    float Restitution() const { return 0.0f; }
+    float Friction() const { return 1.0f; }
+    float StopVelocity() const { return 1.0f; }
+};
 
 // Clase que encapsula el rectángulo
 class Rect {
 private:
-    Rectangle rect;
+    Body<2> body;           // Esquina superior izquierda
+    float width;
+    float height;
     Color color;
-    float speed;
-    bool isMoving;
 
 public:
     // Constructor
     Rect(float x, float y, float width, float height, Color col, float spd) 
-        : rect({x, y, width, height}), color(col), speed(spd), isMoving(true) {}
+        : body{{x, y}, {spd, 0.0f}, true}, width(width), height(height), color(col) {}
 
 
 
-    // Actualizar posición
+    // Actualizar posición (avanza 'speed' píxeles por llamada)
     void Update(int screenWidth) {
-        if (!isMoving) {
+        if (!body.isMoving) {
             return;
         }
 
-        rect.x += speed;
-            
-        if (rect.x + rect.width >= screenWidth) {
-            rect.x = screenWidth - rect.width;
-            isMoving = false;
-        }
+        Physics::Integrate(body, 1.0f, WallPhysics{});
+        Physics::ResolveSurface(body, screenWidth - width, WallPhysics{});
     }
 
     void Draw() {
+        Rectangle rect = {body.position[0], body.position[1], width, height};
         DrawRectangleRec(rect, color);
         DrawRectangleLinesEx(rect, 10, BLACK);
     }
 
     // Getters
-    bool GetIsMoving() const { return isMoving; }
-    float GetX() const { return rect.x; }
-    float GetY() const { return rect.y; }
+    bool GetIsMoving() const { return body.isMoving; }
+    float GetX() const { return body.position[0]; }
+    float GetY() const { return body.position[1]; }
 };
 
 #endif // RECT_H
@@ -0,0 +1,21 @@
+#ifndef SHOT_SWEEP_H
+#define SHOT_SWEEP_H
+
+// Rejilla de ángulo horizontal × elevación que recorren los barridos de golpes
+// (mapa de margen sobre la red y datasets de trayectorias). El rango coincide con
+// los sliders de la interfaz.
+struct ShotSweep {
+    static constexpr float MIN_ANGLE = -90.0f;
+    static constexpr float MAX_ANGLE = 90.0f;
+    static constexpr float MIN_ELEVATION = -45.0f;
+    static constexpr float MAX_ELEVATION = 45.0f;
+    static constexpr float STEP_DEG = 2.0f;
+
+    static constexpr int GetAngleCount() { return (int)((MAX_ANGLE - MIN_ANGLE) / STEP_DEG) + 1; }
+    static constexpr int GetElevationCount() { return (int)((MAX_ELEVATION - MIN_ELEVATION) / STEP_DEG) + 1; }
+
+    static constexpr float GetAngle(int column) { return MIN_ANGLE + column * STEP_DEG; }
+    static constexpr float GetElevation(int row) { return MIN_ELEVATION + row * STEP_DEG; }
+};
+
+#endif // SHOT_SWEEP_H
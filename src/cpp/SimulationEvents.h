@@ -0,0 +1,79 @@
+#ifndef SIMULATION_EVENTS_H
+#define SIMULATION_EVENTS_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Tipos de evento que emite la física (StepBall). El valor es estable: JS lo lee tal cual
+enum class SimEventType : uint32_t {
+    Bounce = 0,     // Bote en el suelo. position = punto de contacto; value = velocidad vertical de impacto
+    NetHit = 1,     // Choque con la red. position = punto de contacto; value = su altura sobre el suelo
+    Stop = 2,       // La pelota se detiene. position = centro de la pelota
+    NetCrossed = 3  // El centro cruza el plano de la red. position = centro en el cruce;
+                    // value = margen del punto más bajo sobre la red
+};
+
+// Evento de simulación. Solo campos de 32 bits (28 bytes): JS lee el lote
+// directamente como Uint32Array/Float32Array sin decodificar estructuras
+struct SimEvent {
+    SimEventType type;
+    uint32_t source;        // Pelota que lo emite (hueco de la arena, 0 = pelota principal)
+    float time;             // Segundos: desde el golpe o tiempo de simulación, según quien lo consuma
+    Vector3 position;       // Punto del evento (ver SimEventType)
+    float value;            // Dato propio del tipo (ver SimEventType)
+};
+
+static_assert(sizeof(SimEvent) == 28, "SimEvent debe ser 7 campos de 32 bits");
+static_assert(std::is_trivially_copyable<SimEvent>::value, "SimEvent debe poder copiarse con memcpy");
+
+// Cola de eventos de capacidad fija reservada de antemano. Emitir un evento es
+// una escritura en un array; si la cola está llena el evento se descarta y se
+// cuenta, nunca se reserva memoria. El consumidor la recorre y la vacía (una vez
+// por paso en los simuladores por lotes, una vez por frame hacia JS).
+class SimEventQueue {
+private:
+    std::unique_ptr<SimEvent[]> owned;  // Vacío si la memoria la aporta el llamador
+    SimEvent* events;
+    uint32_t capacity;
+    uint32_t count = 0;
+    uint32_t dropped = 0;   // Eventos perdidos desde el último Clear()
+
+public:
+    explicit SimEventQueue(uint32_t capacity)
+        : owned(new SimEvent[capacity]), events(owned.get()), capacity(capacity) {}
+
+    // Sobre un array del llamador (p. ej. en la pila de un simulador): ni siquiera
+    // crear la cola reserva memoria
+    SimEventQueue(SimEvent* storage, uint32_t capacity)
+        : events(storage), capacity(capacity) {}
+
+    void Push(SimEventType type, uint32_t source, float time, Vector3 position, float value = 0.0f) {
+        if (count == capacity) {
+            dropped++;
+            return;
+        }
+        events[count++] = {type, source, time, position, value};
+    }
+
+    void Push(const SimEvent& event) {
+        Push(event.type, event.source, event.time, event.position, event.value);
+    }
+
+    void Clear() {
+        count = 0;
+        dropped = 0;
+    }
+
+    const SimEvent& operator[](uint32_t i) const { return events[i]; }
+    const SimEvent* begin() const { return events; }
+    const SimEvent* end() const { return events + count; }
+    const SimEvent* GetData() const { return events; }
+
+    uint32_t GetCount() const { return count; }
+    uint32_t GetCapacity() const { return capacity; }
+    uint32_t GetDropped() const { return dropped; }
+};
+
+#endif // SIMULATION_EVENTS_H
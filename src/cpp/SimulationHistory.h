@@ -0,0 +1,256 @@
+#ifndef SIMULATION_HISTORY_H
+#define SIMULATION_HISTORY_H
+
+#include "BallState.h"
+#include "TrajectoryCache.h"
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Instantánea de la simulación en un tick. Compacta y sin punteros: la
+// trayectoria del golpe en curso no se copia, se referencia por su número de
+// golpe en la tabla compartida de SimulationHistory. Durante la reproducción la
+// velocidad guardada es la del desplazamiento del tick (Ball3D::Follow), así que
+// la instantánea se puede continuar con la física aunque el golpe ya no esté en la tabla.
+struct SimulationSnapshot {
+    BallState ball;         // Posición, velocidad, spin y si se mueve
+    uint32_t tick;          // Tick de simulación al que corresponde
+    uint32_t shotSerial;    // Último golpe lanzado (0 = ninguno): la estela de la pelota es la suya
+    float shotTime;         // Tiempo de reproducción del golpe (negativo si ya no se reproduce)
+};
+
+static_assert(std::is_trivially_copyable<SimulationSnapshot>::value, "SimulationSnapshot debe poder copiarse con memcpy");
+
+// Historial de instantáneas con ramas, en un buffer circular reservado de antemano.
+// Cada instantánea sabe cuál la precede, así que el historial es un árbol: al
+// rebobinar y seguir simulando, la nueva rama cuelga de la instantánea a la que
+// se rebobinó y comparte con la original todo el prefijo anterior sin copiarlo.
+// La rama original sigue ahí y se puede volver a ella (SelectBranch). Si tras
+// rebobinar la simulación repite lo ya grabado, se sigue por esa rama en lugar
+// de abrir otra igual.
+//
+// Las instantáneas grabadas seguidas en una rama ocupan ids consecutivos (un
+// tramo), así que guardar es O(1) y retroceder n ticks salta tramo a tramo en
+// lugar de instantánea a instantánea. Con el buffer lleno se sobrescriben las
+// más antiguas de cualquier rama; una rama cuyo final se sobrescribe desaparece.
+class SimulationHistory {
+private:
+    static const uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        SimulationSnapshot snapshot;
+        uint32_t segmentStart;      // Id del primer nodo de su tramo
+        uint32_t segmentParent;     // Id del nodo que precede al tramo (NONE = ninguno)
+    };
+
+    std::unique_ptr<Node[]> nodes;
+    uint32_t capacity;
+    uint32_t nextId = 0;            // El nodo con id i está en nodes[i % capacity] (ids de 32 bits: ~2 años a 60 ticks/s)
+    uint32_t cursor = NONE;         // Instantánea actual
+
+    static const uint32_t MAX_BRANCHES = 8;
+    uint32_t branchTips[MAX_BRANCHES];  // Última instantánea de cada rama
+    uint32_t branchCount = 0;
+    uint32_t activeBranch = 0;
+
+    // Trayectorias referenciadas por las instantáneas. Las trayectorias son
+    // inmutables, así que todas las ramas comparten el mismo shared_ptr.
+    static const uint32_t MAX_SHOTS = 64;
+    struct Shot {
+        std::shared_ptr<const Trajectory> trajectory;
+        Vector3 origin;         // Donde se lanzó (la trayectoria empieza en el origen cuantizado)
+        uint32_t serial = 0;
+    };
+    Shot shots[MAX_SHOTS];
+    uint32_t nextShotSerial = 1;
+
+    bool IsLive(uint32_t id) const { return id != NONE && id < nextId && nextId - id <= capacity; }
+    const Node& NodeAt(uint32_t id) const { return nodes[id % capacity]; }
+
+    uint32_t Parent(uint32_t id) const {
+        const Node& node = NodeAt(id);
+        return id > node.segmentStart ? id - 1 : node.segmentParent;
+    }
+
+    // Nodo ticksBack instantáneas antes de id en su rama (NONE si ya se sobrescribió)
+    uint32_t Ancestor(uint32_t id, uint32_t ticksBack) const {
+        while (IsLive(id)) {
+            const Node& node = NodeAt(id);
+            uint32_t run = id - node.segmentStart;
+            if (ticksBack <= run) {
+                uint32_t target = id - ticksBack;
+                return IsLive(target) ? target : NONE;
+            }
+            ticksBack -= run + 1;
+            id = node.segmentParent;
+        }
+        return NONE;
+    }
+
+    // Instantáneas que quedan en el buffer desde id hacia atrás (id incluido)
+    uint32_t Depth(uint32_t id) const {
+        const uint32_t oldest = nextId > capacity ? nextId - capacity : 0;
+        uint32_t depth = 0;
+        while (IsLive(id)) {
+            const Node& node = NodeAt(id);
+            if (node.segmentStart < oldest) {
+                return depth + (id - oldest + 1);
+            }
+            depth += id - node.segmentStart + 1;
+            id = node.segmentParent;
+        }
+        return depth;
+    }
+
+    // Instantánea que sigue al cursor en la rama, o NONE si la rama no pasa por él.
+    // A lo largo de una rama los ticks son consecutivos.
+    uint32_t NextOnBranch(uint32_t branch) const {
+        uint32_t tip = branchTips[branch];
+        if (!IsLive(tip) || !IsLive(cursor)) return NONE;
+        uint32_t tipTick = NodeAt(tip).snapshot.tick;
+        uint32_t cursorTick = NodeAt(cursor).snapshot.tick;
+        if (tipTick <= cursorTick) return NONE;
+        uint32_t next = Ancestor(tip, tipTick - cursorTick - 1);
+        return next != NONE && Parent(next) == cursor ? next : NONE;
+    }
+
+    static bool SameState(const SimulationSnapshot& a, const SimulationSnapshot& b) {
+        for (int axis = 0; axis < 3; axis++) {
+            if (a.ball.body.position[axis] != b.ball.body.position[axis] ||
+                a.ball.body.velocity[axis] != b.ball.body.velocity[axis]) {
+                return false;
+            }
+        }
+        return a.ball.body.isMoving == b.ball.body.isMoving && a.ball.spinX == b.ball.spinX &&
+               a.ball.spinZ == b.ball.spinZ && a.tick == b.tick && a.shotSerial == b.shotSerial &&
+               a.shotTime == b.shotTime;
+    }
+
+    // Olvida las ramas cuyo final ya se ha sobrescrito
+    void PruneBranches() {
+        uint32_t kept = 0;
+        for (uint32_t b = 0; b < branchCount; b++) {
+            if (!IsLive(branchTips[b])) continue;
+            if (b == activeBranch) activeBranch = kept;
+            branchTips[kept++] = branchTips[b];
+        }
+        branchCount = kept;
+        if (activeBranch >= branchCount) activeBranch = 0;
+    }
+
+    // Abre una rama que termina en id; sin hueco, sustituye la rama (no activa) más antigua
+    void StartBranch(uint32_t id) {
+        uint32_t branch = branchCount;
+        if (branchCount < MAX_BRANCHES) {
+            branchCount++;
+        } else {
+            branch = activeBranch == 0 ? 1 : 0;
+            for (uint32_t b = 0; b < branchCount; b++) {
+                if (b != activeBranch && branchTips[b] < branchTips[branch]) branch = b;
+            }
+        }
+        branchTips[branch] = id;
+        activeBranch = branch;
+    }
+
+public:
+    explicit SimulationHistory(uint32_t capacity)
+        : nodes(new Node[capacity]), capacity(capacity) {}
+
+    // Registra la trayectoria de un golpe nuevo y devuelve su número
+    uint32_t AddShot(std::shared_ptr<const Trajectory> trajectory, Vector3 origin) {
+        uint32_t serial = nextShotSerial++;
+        shots[serial % MAX_SHOTS] = {std::move(trajectory), origin, serial};
+        return serial;
+    }
+
+    // nullptr si el golpe ya no está en la tabla (más de MAX_SHOTS golpes después)
+    std::shared_ptr<const Trajectory> GetShot(uint32_t serial) const {
+        if (serial == 0 || shots[serial % MAX_SHOTS].serial != serial) return nullptr;
+        return shots[serial % MAX_SHOTS].trajectory;
+    }
+
+    // Origen de un golpe de la tabla; false si ya no está
+    bool GetShotOrigin(uint32_t serial, Vector3& outOrigin) const {
+        if (serial == 0 || shots[serial % MAX_SHOTS].serial != serial) return false;
+        outOrigin = shots[serial % MAX_SHOTS].origin;
+        return true;
+    }
+
+    // Guarda la instantánea del tick siguiente al cursor; con el buffer lleno
+    // sobrescribe la más antigua
+    void Record(const SimulationSnapshot& snapshot) {
+        PruneBranches();
+        bool atActiveTip = branchCount > 0 && cursor == branchTips[activeBranch];
+
+        // Tras rebobinar, si la simulación repite una rama ya grabada se avanza por ella
+        if (!atActiveTip && IsLive(cursor)) {
+            for (uint32_t b = 0; b < branchCount; b++) {
+                uint32_t next = NextOnBranch(b);
+                if (next != NONE && SameState(NodeAt(next).snapshot, snapshot)) {
+                    cursor = next;
+                    activeBranch = b;
+                    return;
+                }
+            }
+        }
+
+        // El tramo continúa si el cursor es el último nodo grabado. Se lee antes de
+        // escribir: el nodo nuevo puede ocupar el hueco del cursor si es el más antiguo
+        uint32_t segmentStart = nextId;
+        uint32_t segmentParent = IsLive(cursor) ? cursor : NONE;
+        if (IsLive(cursor) && cursor == nextId - 1) {
+            segmentStart = NodeAt(cursor).segmentStart;
+            segmentParent = NodeAt(cursor).segmentParent;
+        }
+        uint32_t id = nextId++;
+        nodes[id % capacity] = {snapshot, segmentStart, segmentParent};
+        cursor = id;
+
+        if (atActiveTip) {
+            branchTips[activeBranch] = id;
+        } else {
+            StartBranch(id);
+        }
+    }
+
+    // Instantánea de hace ticksBack ticks en la rama actual (0 = la actual).
+    // Requiere ticksBack < GetCount()
+    const SimulationSnapshot& Get(uint32_t ticksBack) const {
+        return NodeAt(Ancestor(cursor, ticksBack)).snapshot;
+    }
+
+    // Retrocede ticksBack ticks (limitado a lo guardado) y devuelve la instantánea
+    // en la que queda el cursor. No borra nada: lo que se grabe después abre otra rama.
+    const SimulationSnapshot* Rewind(uint32_t ticksBack) {
+        uint32_t depth = Depth(cursor);
+        if (depth == 0) return nullptr;
+        if (ticksBack >= depth) ticksBack = depth - 1;
+        cursor = Ancestor(cursor, ticksBack);
+        return &NodeAt(cursor).snapshot;
+    }
+
+    // Salta al final de una rama. nullptr si no existe
+    const SimulationSnapshot* SelectBranch(uint32_t branch) {
+        PruneBranches();
+        if (branch >= branchCount) return nullptr;
+        activeBranch = branch;
+        cursor = branchTips[branch];
+        return &NodeAt(cursor).snapshot;
+    }
+
+    void Clear() {
+        nextId = 0;
+        cursor = NONE;
+        branchCount = 0;
+        activeBranch = 0;
+    }
+
+    // Instantáneas que quedan en la rama actual hasta el cursor
+    uint32_t GetCount() const { return Depth(cursor); }
+    uint32_t GetCapacity() const { return capacity; }
+    uint32_t GetBranchCount() const { return branchCount; }
+    uint32_t GetActiveBranch() const { return activeBranch; }
+};
+
+#endif // SIMULATION_HISTORY_H
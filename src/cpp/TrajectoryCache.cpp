@@ -0,0 +1,286 @@
+#include "TrajectoryCache.h"
+#include "BallState.h"
+#include <cmath>
+#include <cstring>
+
+// Paso fijo de la simulación y duración máxima de un golpe
+const float SIMULATION_STEP = 1.0f / 120.0f;
+const float MAX_SIMULATION_TIME = 15.0f;
+
+// Resolución de la cuantización de la clave
+const float ANGLE_QUANTUM = 0.05f;      // grados
+const float SPEED_QUANTUM = 1.0f;       // unidades/s
+const float SPIN_QUANTUM = 0.5f;        // unidades/s
+const float POSITION_QUANTUM = 0.5f;    // unidades
+
+Vector3 CalculateVelocityFromAngle(float speed, float angleDeg, float elevationDeg) {
+    // Convertir grados a radianes
+    float angleRad = angleDeg * M_PI / 180.0f;
+    float elevationRad = elevationDeg * M_PI / 180.0f;
+
+    // Calcular componentes de velocidad
+    float velX = speed * cosf(elevationRad) * sinf(angleRad);
+    float velY = speed * sinf(elevationRad);
+    float velZ = speed * cosf(elevationRad) * cosf(angleRad);
+
+    return {velX, velY, velZ};
+}
+
+size_t Trajectory::GetByteSize() const {
+    return sizeof(Trajectory)
+        + path.capacity() * sizeof(Vector3)
+        + events.capacity() * sizeof(SimEvent);
+}
+
+// Eventos que puede emitir StepBall en un solo paso (red, bote y parada)
+static const uint32_t MAX_EVENTS_PER_STEP = 4;
+
+std::shared_ptr<const Trajectory> SimulateTrajectory(const ShotParams& shot, const Court& court, float ballRadius) {
+    auto traj = std::make_shared<Trajectory>();
+    traj->sampleInterval = SIMULATION_STEP;
+
+    float floorY = court.GetFloorY();
+    float netZ = court.GetMaxZ() / 2.0f;
+
+    Vector3 velocity = CalculateVelocityFromAngle(shot.speed, shot.angleDeg, shot.elevationDeg);
+    BallState ball = BallState::Make(shot.origin, velocity, shot.spin);
+
+    bool crossedNet = false;
+    traj->netClearance = NAN;
+    traj->path.reserve((size_t)(2.0f / SIMULATION_STEP));
+    traj->path.push_back(shot.origin);
+
+    SimEvent stepEvents[MAX_EVENTS_PER_STEP];
+    SimEventQueue events(stepEvents, MAX_EVENTS_PER_STEP);
+    float time = 0.0f;
+    while (ball.body.isMoving && time < MAX_SIMULATION_TIME) {
+        time += SIMULATION_STEP;
+        events.Clear();
+        StepBall(ball, SIMULATION_STEP, ballRadius, floorY, netZ, court, &events, time);
+        traj->path.push_back(ball.GetPosition());
+
+        for (const SimEvent& event : events) {
+            if (!crossedNet) {
+                crossedNet = GetNetClearance(event, court, ballRadius, traj->netClearance);
+            }
+            if (event.type == SimEventType::Bounce && !traj->hasLanding) {
+                traj->hasLanding = true;
+                traj->landing = event.position;
+                traj->flightTime = event.time;
+            }
+            traj->events.push_back(event);
+        }
+    }
+
+    traj->path.shrink_to_fit();
+    traj->events.shrink_to_fit();
+    return traj;
+}
+
+float SimulateNetClearance(const ShotParams& shot, const Court& court, float ballRadius) {
+    float floorY = court.GetFloorY();
+    float netZ = court.GetMaxZ() / 2.0f;
+
+    Vector3 velocity = CalculateVelocityFromAngle(shot.speed, shot.angleDeg, shot.elevationDeg);
+    BallState ball = BallState::Make(shot.origin, velocity, shot.spin);
+
+    SimEvent stepEvents[MAX_EVENTS_PER_STEP];
+    SimEventQueue events(stepEvents, MAX_EVENTS_PER_STEP);
+    float time = 0.0f;
+    float clearance;
+    while (ball.body.isMoving && time < MAX_SIMULATION_TIME) {
+        time += SIMULATION_STEP;
+        events.Clear();
+        StepBall(ball, SIMULATION_STEP, ballRadius, floorY, netZ, court, &events, time);
+
+        for (const SimEvent& event : events) {
+            if (GetNetClearance(event, court, ballRadius, clearance)) {
+                return clearance;
+            }
+        }
+    }
+    return NAN;
+}
+
+ShotSummary SimulateShotSummary(const ShotParams& shot, const Court& court, float ballRadius) {
+    ShotSummary summary;
+    float floorY = court.GetFloorY();
+    float netZ = court.GetMaxZ() / 2.0f;
+
+    Vector3 velocity = CalculateVelocityFromAngle(shot.speed, shot.angleDeg, shot.elevationDeg);
+    BallState ball = BallState::Make(shot.origin, velocity, shot.spin);
+
+    SimEvent stepEvents[MAX_EVENTS_PER_STEP];
+    SimEventQueue events(stepEvents, MAX_EVENTS_PER_STEP);
+    bool crossedNet = false;
+    float time = 0.0f;
+    while (ball.body.isMoving && time < MAX_SIMULATION_TIME && !(crossedNet && summary.hasLanding)) {
+        time += SIMULATION_STEP;
+        events.Clear();
+        StepBall(ball, SIMULATION_STEP, ballRadius, floorY, netZ, court, &events, time);
+
+        for (const SimEvent& event : events) {
+            if (!crossedNet) {
+                crossedNet = GetNetClearance(event, court, ballRadius, summary.netClearance);
+            }
+            if (event.type == SimEventType::Bounce && !summary.hasLanding) {
+                summary.hasLanding = true;
+                summary.landing = event.position;
+                summary.flightTime = event.time;
+            }
+        }
+    }
+    return summary;
+}
+
+bool TrajectoryCache::Key::operator==(const Key& other) const {
+    for (int i = 0; i < KEY_FIELDS; i++) {
+        if (q[i] != other.q[i]) return false;
+    }
+    return true;
+}
+
+size_t TrajectoryCache::KeyHash::operator()(const Key& key) const {
+    // FNV-1a sobre los campos cuantizados
+    uint64_t hash = 1469598103934665603ULL;
+    for (int i = 0; i < KEY_FIELDS; i++) {
+        uint32_t v = (uint32_t)key.q[i];
+        for (int b = 0; b < 4; b++) {
+            hash ^= (v >> (b * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    }
+    return (size_t)hash;
+}
+
+static int32_t Quantize(float value, float quantum) {
+    return (int32_t)lroundf(value / quantum);
+}
+
+// Bits exactos del valor: los parámetros físicos no se cuantizan, la simulación
+// usa los de la pista tal cual y cualquier cambio debe dar otra clave
+static int32_t FloatBits(float value) {
+    int32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+TrajectoryCache::Key TrajectoryCache::MakeKey(const ShotParams& shot, const Court& court, float ballRadius) {
+    Key key;
+    key.q[0] = Quantize(shot.origin.x, POSITION_QUANTUM);
+    key.q[1] = Quantize(shot.origin.y, POSITION_QUANTUM);
+    key.q[2] = Quantize(shot.origin.z, POSITION_QUANTUM);
+    key.q[3] = Quantize(shot.speed, SPEED_QUANTUM);
+    key.q[4] = Quantize(shot.angleDeg, ANGLE_QUANTUM);
+    key.q[5] = Quantize(shot.elevationDeg, ANGLE_QUANTUM);
+    key.q[6] = Quantize(shot.spin.x, SPIN_QUANTUM);
+    key.q[7] = Quantize(shot.spin.y, SPIN_QUANTUM);
+    key.q[8] = Quantize(shot.spin.z, SPIN_QUANTUM);
+    // Configuración de la pista y de la pelota
+    key.q[9] = Quantize(court.GetWidth(), POSITION_QUANTUM);
+    key.q[10] = Quantize(court.GetFloorY(), POSITION_QUANTUM);
+    key.q[11] = Quantize(ballRadius, POSITION_QUANTUM);
+    const PhysicsProfile& physics = court.GetPhysics();
+    key.q[12] = FloatBits(physics.gravity);
+    key.q[13] = FloatBits(physics.restitution);
+    key.q[14] = FloatBits(physics.frictionXZ);
+    key.q[15] = FloatBits(physics.minVelocity);
+    return key;
+}
+
+ShotParams TrajectoryCache::Dequantize(const Key& key) {
+    ShotParams shot;
+    shot.origin = {key.q[0] * POSITION_QUANTUM, key.q[1] * POSITION_QUANTUM, key.q[2] * POSITION_QUANTUM};
+    shot.speed = key.q[3] * SPEED_QUANTUM;
+    shot.angleDeg = key.q[4] * ANGLE_QUANTUM;
+    shot.elevationDeg = key.q[5] * ANGLE_QUANTUM;
+    shot.spin = {key.q[6] * SPIN_QUANTUM, key.q[7] * SPIN_QUANTUM, key.q[8] * SPIN_QUANTUM};
+    return shot;
+}
+
+TrajectoryCache::TrajectoryCache(size_t budgetBytes) : budgetBytes(budgetBytes) {
+    UpdateStats();
+}
+
+std::shared_ptr<const Trajectory> TrajectoryCache::GetOrSimulate(const ShotParams& shot, const Court& court, float ballRadius) {
+    Key key = MakeKey(shot, court, ballRadius);
+
+    auto found = index.find(key);
+    if (found != index.end()) {
+        // Acierto: mover la entrada al principio de la lista LRU
+        lru.splice(lru.begin(), lru, found->second);
+        stats.hits++;
+        return found->second->trajectory;
+    }
+
+    stats.misses++;
+    std::shared_ptr<const Trajectory> traj = SimulateTrajectory(Dequantize(key), court, key.q[11] * POSITION_QUANTUM);
+
+    // Una trayectoria mayor que todo el presupuesto se devuelve sin guardarla
+    size_t bytes = traj->GetByteSize() + sizeof(Entry) + sizeof(Key);
+    if (bytes <= budgetBytes) {
+        lru.push_front({key, traj, bytes});
+        index[key] = lru.begin();
+        usedBytes += bytes;
+        EvictToBudget();
+    }
+
+    UpdateStats();
+    return traj;
+}
+
+void TrajectoryCache::EvictToBudget() {
+    while (usedBytes > budgetBytes && !lru.empty()) {
+        // Las trayectorias en reproducción siguen vivas gracias al shared_ptr
+        Entry& oldest = lru.back();
+        usedBytes -= oldest.bytes;
+        index.erase(oldest.key);
+        lru.pop_back();
+        stats.evictions++;
+    }
+}
+
+void TrajectoryCache::SetBudget(size_t bytes) {
+    budgetBytes = bytes;
+    EvictToBudget();
+    UpdateStats();
+}
+
+void TrajectoryCache::Clear() {
+    lru.clear();
+    index.clear();
+    usedBytes = 0;
+    UpdateStats();
+}
+
+void TrajectoryCache::UpdateStats() {
+    stats.entries = (uint32_t)lru.size();
+    stats.bytes = (uint32_t)usedBytes;
+    stats.budgetBytes = (uint32_t)budgetBytes;
+}
+
+bool TrajectoryPlayer::Advance(float deltaTime, Vector3& outPosition) {
+    if (!trajectory || trajectory->path.empty()) {
+        trajectory.reset();
+        return false;
+    }
+
+    time += deltaTime;
+    const std::vector<Vector3>& path = trajectory->path;
+    float samplePos = time / trajectory->sampleInterval;
+    size_t i = (size_t)samplePos;
+
+    if (i + 1 >= path.size()) {
+        // Fin de la trayectoria: quedarse en la última muestra
+        outPosition = path.back();
+        trajectory.reset();
+        return false;
+    }
+
+    // Interpolación lineal entre muestras consecutivas
+    float t = samplePos - (float)i;
+    const Vector3& a = path[i];
+    const Vector3& b = path[i + 1];
+    outPosition = {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+    return true;
+}
@@ -0,0 +1,166 @@
+#ifndef TRAJECTORY_CACHE_H
+#define TRAJECTORY_CACHE_H
+
+#include "raylib.h"
+#include "Court.h"
+#include "SimulationEvents.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <utility>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Parámetros de lanzamiento de un golpe
+struct ShotParams {
+    Vector3 origin;         // Posición inicial de la pelota
+    float speed;            // Velocidad inicial (magnitud)
+    float angleDeg;         // Ángulo horizontal en grados
+    float elevationDeg;     // Ángulo vertical en grados
+    Vector3 spin;           // Efecto aplicado en cada bote
+};
+
+// Trayectoria completa de un golpe muestreada a intervalos fijos
+struct Trajectory {
+    float sampleInterval = 0.0f;            // Segundos entre muestras
+    std::vector<Vector3> path;              // path[i] = posición en i * sampleInterval
+    std::vector<SimEvent> events;           // Eventos de la física; time = segundos desde el golpe
+    bool hasLanding = false;
+    Vector3 landing = {0.0f, 0.0f, 0.0f};   // Punto del primer bote
+    float flightTime = 0.0f;                // Tiempo hasta el primer bote
+    float netClearance = 0.0f;              // Margen sobre la red al cruzarla (negativo = tocó la red, NaN = no llegó)
+
+    float GetDuration() const { return path.empty() ? 0.0f : (path.size() - 1) * sampleInterval; }
+    size_t GetByteSize() const;
+};
+
+// Resumen de un golpe sin la trayectoria muestreada (para simulaciones por lotes)
+struct ShotSummary {
+    bool hasLanding = false;
+    Vector3 landing = {0.0f, 0.0f, 0.0f};   // Punto del primer bote
+    float flightTime = NAN;                 // Tiempo hasta el primer bote (NaN si no bota)
+    float netClearance = NAN;               // Mismo criterio que Trajectory::netClearance
+};
+
+// Calcula el vector velocidad a partir de la velocidad y los ángulos del golpe
+Vector3 CalculateVelocityFromAngle(float speed, float angleDeg, float elevationDeg);
+
+// Simula un golpe completo con paso fijo hasta que la pelota se detiene
+std::shared_ptr<const Trajectory> SimulateTrajectory(const ShotParams& shot, const Court& court, float ballRadius);
+
+// Simula un golpe solo hasta que llega a la red (o se detiene antes) y devuelve
+// el margen sobre la red, con el mismo criterio que Trajectory::netClearance.
+// Es mucho más barato que SimulateTrajectory: no guarda la trayectoria.
+float SimulateNetClearance(const ShotParams& shot, const Court& court, float ballRadius);
+
+// Simula un golpe hasta su primer bote y su paso por la red, sin guardar la trayectoria
+ShotSummary SimulateShotSummary(const ShotParams& shot, const Court& court, float ballRadius);
+
+// Margen sobre la red de un evento NetHit o NetCrossed (el primero de un golpe
+// define Trajectory::netClearance). Devuelve false para el resto de eventos.
+// NetCrossed ya lo trae en value; en NetHit se calcula con la altura del contacto
+inline bool GetNetClearance(const SimEvent& event, const Court& court, float ballRadius, float& outClearance) {
+    if (event.type == SimEventType::NetCrossed) {
+        outClearance = event.value;
+        return true;
+    }
+    if (event.type == SimEventType::NetHit) {
+        outClearance = (event.value - ballRadius) - court.GetNetHeightAtX(event.position.x);
+        return true;
+    }
+    return false;
+}
+
+// Paso fijo de la simulación y duración máxima de un golpe
+extern const float SIMULATION_STEP;
+extern const float MAX_SIMULATION_TIME;
+
+// Contadores de la caché. Solo enteros de 32 bits: JS los lee directamente de HEAPU32
+struct TrajectoryCacheStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;
+    uint32_t entries = 0;
+    uint32_t bytes = 0;
+    uint32_t budgetBytes = 0;
+};
+
+// Caché LRU de trayectorias completas.
+// La clave es el golpe cuantizado (ángulos, velocidad, spin, origen) más la
+// configuración de la pista y su perfil físico, así que golpes casi idénticos
+// comparten entrada y un cambio de perfil no reutiliza trayectorias antiguas.
+// La simulación se hace siempre con los parámetros cuantizados, de modo que el
+// resultado depende solo de la clave y es el mismo con o sin caché.
+class TrajectoryCache {
+private:
+    static const int KEY_FIELDS = 16;
+
+    struct Key {
+        int32_t q[KEY_FIELDS];
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<const Trajectory> trajectory;
+        size_t bytes;
+    };
+
+    std::list<Entry> lru;   // Más reciente al principio
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    size_t budgetBytes;
+    size_t usedBytes = 0;
+    TrajectoryCacheStats stats;
+
+    static Key MakeKey(const ShotParams& shot, const Court& court, float ballRadius);
+    static ShotParams Dequantize(const Key& key);
+    void EvictToBudget();
+    void UpdateStats();
+
+public:
+    explicit TrajectoryCache(size_t budgetBytes);
+
+    // Devuelve la trayectoria del golpe, simulándola solo si no está en caché
+    std::shared_ptr<const Trajectory> GetOrSimulate(const ShotParams& shot, const Court& court, float ballRadius);
+
+    void SetBudget(size_t bytes);
+    void Clear();
+
+    const TrajectoryCacheStats& GetStats() const { return stats; }
+};
+
+// Reproduce una trayectoria cacheada interpolando entre sus muestras
+class TrajectoryPlayer {
+private:
+    std::shared_ptr<const Trajectory> trajectory;
+    float time = 0.0f;
+
+public:
+    void Start(std::shared_ptr<const Trajectory> traj) {
+        trajectory = std::move(traj);
+        time = 0.0f;
+    }
+
+    // Reanuda una reproducción en un instante concreto (al restaurar una instantánea)
+    void Seek(std::shared_ptr<const Trajectory> traj, float atTime) {
+        trajectory = std::move(traj);
+        time = atTime;
+    }
+
+    void Stop() { trajectory.reset(); }
+    bool IsActive() const { return trajectory != nullptr; }
+    float GetTime() const { return time; }
+    const std::shared_ptr<const Trajectory>& GetTrajectory() const { return trajectory; }
+
+    // Avanza la reproducción y escribe la posición actual.
+    // Devuelve false cuando la trayectoria ha terminado (y deja de estar activa)
+    bool Advance(float deltaTime, Vector3& outPosition);
+};
+
+#endif // TRAJECTORY_CACHE_H
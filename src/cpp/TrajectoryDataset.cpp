@@ -0,0 +1,313 @@
+#include "TrajectoryDataset.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const char DATASET_MAGIC[4] = {'T', 'N', 'D', 'S'};
+static const size_t NAME_SIZE = 16;
+static const size_t HEADER_SIZE = 16;
+static const size_t TRAILER_SIZE = 16;
+static const size_t FILE_BUFFER_SIZE = 1 << 20;    // 1 MB: un trozo completo cabe de sobra
+static const uint32_t MAX_COLUMNS = 256;            // Límite del lector (el escritor usa DATASET_COLUMN_COUNT)
+
+static const char* const COLUMN_NAMES[DATASET_COLUMN_COUNT] = {
+    "origin_x", "origin_y", "origin_z",
+    "speed", "angle", "elevation",
+    "spin_x", "spin_z",
+    "landing_x", "landing_z",
+    "net_clearance", "flight_time"
+};
+
+const char* GetDatasetColumnName(int column) {
+    return column >= 0 && column < DATASET_COLUMN_COUNT ? COLUMN_NAMES[column] : "";
+}
+
+// fseek/ftell con offsets de 64 bits
+static bool SeekTo(FILE* file, uint64_t offset) {
+#if defined(_WIN32)
+    return _fseeki64(file, (int64_t)offset, SEEK_SET) == 0;
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+static bool TellPosition(FILE* file, uint64_t& offset) {
+#if defined(_WIN32)
+    int64_t position = _ftelli64(file);
+#else
+    int64_t position = (int64_t)ftello(file);
+#endif
+    if (position < 0) return false;
+    offset = (uint64_t)position;
+    return true;
+}
+
+TrajectoryDatasetWriter::TrajectoryDatasetWriter(uint32_t chunkRows)
+    : chunkRows(chunkRows > 0 ? chunkRows : DEFAULT_CHUNK_ROWS) {
+    for (std::vector<float>& column : columns) {
+        column.reserve(this->chunkRows);
+    }
+}
+
+TrajectoryDatasetWriter::~TrajectoryDatasetWriter() {
+    Abort();
+}
+
+bool TrajectoryDatasetWriter::WriteBytes(const void* data, size_t size) {
+    if (failed) return false;
+    if (fwrite(data, 1, size, file) != size) {
+        LOG_ERROR("Error escribiendo el dataset de trayectorias");
+        failed = true;
+        return false;
+    }
+    offset += size;
+    return true;
+}
+
+bool TrajectoryDatasetWriter::Open(const char* path) {
+    if (file) {
+        Close();
+    }
+    this->path = path;
+    partPath = this->path + ".part";
+    file = fopen(partPath.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("No se pudo crear el dataset de trayectorias");
+        return false;
+    }
+    fileBuffer.resize(FILE_BUFFER_SIZE);
+    setvbuf(file, fileBuffer.data(), _IOFBF, fileBuffer.size());
+
+    for (std::vector<float>& column : columns) {
+        column.clear();
+    }
+    index.clear();
+    totalRows = 0;
+    offset = 0;
+    failed = false;
+
+    uint32_t header[3] = {VERSION, DATASET_COLUMN_COUNT, chunkRows};
+    WriteBytes(DATASET_MAGIC, sizeof(DATASET_MAGIC));
+    WriteBytes(header, sizeof(header));
+    return !failed;
+}
+
+void TrajectoryDatasetWriter::Append(const ShotParams& shot, const ShotSummary& summary) {
+    if (!file) return;
+
+    float landingX = summary.hasLanding ? summary.landing.x : NAN;
+    float landingZ = summary.hasLanding ? summary.landing.z : NAN;
+
+    columns[DATASET_ORIGIN_X].push_back(shot.origin.x);
+    columns[DATASET_ORIGIN_Y].push_back(shot.origin.y);
+    columns[DATASET_ORIGIN_Z].push_back(shot.origin.z);
+    columns[DATASET_SPEED].push_back(shot.speed);
+    columns[DATASET_ANGLE].push_back(shot.angleDeg);
+    columns[DATASET_ELEVATION].push_back(shot.elevationDeg);
+    columns[DATASET_SPIN_X].push_back(shot.spin.x);
+    columns[DATASET_SPIN_Z].push_back(shot.spin.z);
+    columns[DATASET_LANDING_X].push_back(landingX);
+    columns[DATASET_LANDING_Z].push_back(landingZ);
+    columns[DATASET_NET_CLEARANCE].push_back(summary.netClearance);
+    columns[DATASET_FLIGHT_TIME].push_back(summary.flightTime);
+    totalRows++;
+
+    if (columns[0].size() >= chunkRows) {
+        FlushChunk();
+    }
+}
+
+void TrajectoryDatasetWriter::FlushChunk() {
+    const uint32_t rows = (uint32_t)columns[0].size();
+    if (rows == 0) return;
+
+    for (std::vector<float>& column : columns) {
+        DatasetChunkInfo info = {offset, rows, 0, NAN, NAN};
+        for (float value : column) {
+            if (std::isnan(value)) {
+                info.nanCount++;
+            } else {
+                // fminf/fmaxf ignoran el NaN inicial
+                info.min = fminf(info.min, value);
+                info.max = fmaxf(info.max, value);
+            }
+        }
+        index.push_back(info);
+        WriteBytes(column.data(), column.size() * sizeof(float));
+        column.clear();
+    }
+}
+
+bool TrajectoryDatasetWriter::Close() {
+    if (!file) return false;
+
+    FlushChunk();
+
+    // Pie: nombres, recuento e índice de trozos
+    uint64_t footerOffset = offset;
+    for (int c = 0; c < DATASET_COLUMN_COUNT; c++) {
+        char name[NAME_SIZE] = {};
+        strncpy(name, COLUMN_NAMES[c], NAME_SIZE - 1);
+        WriteBytes(name, NAME_SIZE);
+    }
+    uint32_t chunkInfo[2] = {(uint32_t)(index.size() / DATASET_COLUMN_COUNT), 0};
+    WriteBytes(chunkInfo, sizeof(chunkInfo));
+    WriteBytes(&totalRows, sizeof(totalRows));
+    WriteBytes(index.data(), index.size() * sizeof(DatasetChunkInfo));
+
+    uint32_t reserved = 0;
+    WriteBytes(&footerOffset, sizeof(footerOffset));
+    WriteBytes(&reserved, sizeof(reserved));
+    WriteBytes(DATASET_MAGIC, sizeof(DATASET_MAGIC));
+
+    if (fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    fileBuffer.clear();
+    fileBuffer.shrink_to_fit();
+
+    if (!failed) {
+#if defined(_WIN32)
+        remove(path.c_str());   // rename() no reemplaza un archivo existente en Windows
+#endif
+        if (rename(partPath.c_str(), path.c_str()) != 0) {
+            LOG_ERROR("No se pudo renombrar el dataset de trayectorias");
+            failed = true;
+        }
+    }
+    if (failed) {
+        remove(partPath.c_str());
+    }
+    return !failed;
+}
+
+void TrajectoryDatasetWriter::Abort() {
+    if (!file) return;
+    fclose(file);
+    file = nullptr;
+    fileBuffer.clear();
+    fileBuffer.shrink_to_fit();
+    remove(partPath.c_str());
+}
+
+TrajectoryDatasetReader::~TrajectoryDatasetReader() {
+    Close();
+}
+
+void TrajectoryDatasetReader::Close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+    index.clear();
+    names.clear();
+    columnCount = chunkRows = chunkCount = 0;
+    totalRows = 0;
+}
+
+// Un archivo truncado o manipulado se rechaza aquí: después ReadColumn confía en
+// que chunkRows > 0, en que el índice tiene una entrada por columna y trozo y en
+// que cada trozo está entero antes del pie
+bool TrajectoryDatasetReader::Open(const char* path) {
+    Close();
+    file = fopen(path, "rb");
+    if (!file) return false;
+
+    char magic[4];
+    uint32_t header[3];
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, DATASET_MAGIC, 4) != 0 ||
+        fread(header, sizeof(uint32_t), 3, file) != 3 || header[0] != TrajectoryDatasetWriter::VERSION ||
+        header[1] == 0 || header[1] > MAX_COLUMNS || header[2] == 0) {
+        Close();
+        return false;
+    }
+    columnCount = header[1];
+    chunkRows = header[2];
+
+    // La cola, al final del archivo, indica dónde empieza el pie
+    uint64_t footerOffset;
+    uint64_t trailerOffset;
+    if (fseek(file, -(long)TRAILER_SIZE, SEEK_END) != 0 || !TellPosition(file, trailerOffset) ||
+        fread(&footerOffset, sizeof(footerOffset), 1, file) != 1 ||
+        fseek(file, 4, SEEK_CUR) != 0 ||
+        fread(magic, 1, 4, file) != 4 || memcmp(magic, DATASET_MAGIC, 4) != 0 ||
+        footerOffset < HEADER_SIZE || footerOffset > trailerOffset || !SeekTo(file, footerOffset)) {
+        Close();
+        return false;
+    }
+
+    uint32_t chunkInfo[2];
+    names.resize((size_t)columnCount * NAME_SIZE);
+    if (fread(names.data(), 1, names.size(), file) != names.size() ||
+        fread(chunkInfo, sizeof(uint32_t), 2, file) != 2 ||
+        fread(&totalRows, sizeof(totalRows), 1, file) != 1) {
+        Close();
+        return false;
+    }
+    chunkCount = chunkInfo[0];
+
+    // El número de trozos debe cuadrar con las filas, y el índice debe ocupar
+    // exactamente lo que queda hasta la cola (así no se reserva más de lo que hay)
+    uint64_t indexOffset = footerOffset + names.size() + sizeof(chunkInfo) + sizeof(totalRows);
+    uint64_t indexSize = (uint64_t)chunkCount * columnCount * sizeof(DatasetChunkInfo);
+    if (chunkCount != totalRows / chunkRows + (totalRows % chunkRows != 0 ? 1 : 0) ||
+        indexOffset > trailerOffset || indexSize != trailerOffset - indexOffset) {
+        Close();
+        return false;
+    }
+
+    index.resize((size_t)chunkCount * columnCount);
+    if (fread(index.data(), sizeof(DatasetChunkInfo), index.size(), file) != index.size()) {
+        Close();
+        return false;
+    }
+
+    // Todos los trozos tienen chunkRows filas salvo el último, y sus datos están antes del pie
+    for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+        uint64_t rows = chunk + 1 < chunkCount ? chunkRows : totalRows - (uint64_t)chunk * chunkRows;
+        for (uint32_t c = 0; c < columnCount; c++) {
+            const DatasetChunkInfo& info = GetChunkInfo((int)c, chunk);
+            if (info.rows != rows || info.offset < HEADER_SIZE ||
+                info.offset > footerOffset || rows * sizeof(float) > footerOffset - info.offset) {
+                Close();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int TrajectoryDatasetReader::FindColumn(const char* name) const {
+    for (uint32_t c = 0; c < columnCount; c++) {
+        if (strncmp(&names[c * NAME_SIZE], name, NAME_SIZE) == 0) {
+            return (int)c;
+        }
+    }
+    return -1;
+}
+
+uint64_t TrajectoryDatasetReader::ReadColumn(int column, uint64_t firstRow, uint64_t count, float* out) const {
+    if (!file || column < 0 || (uint32_t)column >= columnCount || firstRow >= totalRows) {
+        return 0;
+    }
+    count = std::min(count, totalRows - firstRow);
+
+    // Todos los trozos tienen chunkRows filas salvo el último
+    uint64_t read = 0;
+    while (read < count) {
+        uint64_t row = firstRow + read;
+        uint32_t chunk = (uint32_t)(row / chunkRows);
+        uint32_t rowInChunk = (uint32_t)(row % chunkRows);
+        const DatasetChunkInfo& info = GetChunkInfo(column, chunk);
+        uint64_t n = std::min<uint64_t>(count - read, info.rows - rowInChunk);
+
+        if (!SeekTo(file, info.offset + (uint64_t)rowInChunk * sizeof(float)) ||
+            fread(out + read, sizeof(float), n, file) != n) {
+            break;
+        }
+        read += n;
+    }
+    return read;
+}
@@ -0,0 +1,128 @@
+#ifndef TRAJECTORY_DATASET_H
+#define TRAJECTORY_DATASET_H
+
+#include "TrajectoryCache.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Formato columnar para los resultados de simulaciones por lotes (.tds).
+// Todo en little-endian y float32:
+//
+//   Cabecera:  "TNDS" | uint32 versión | uint32 columnas | uint32 filas por trozo
+//   Trozos:    para cada trozo, cada columna seguida (filas × float32)
+//   Pie:       columnas × char[16] nombre | uint32 trozos | uint32 reservado | uint64 filas
+//              trozos × columnas × DatasetChunkInfo (orden: trozo, columna)
+//   Cola:      uint64 offset del pie | uint32 reservado | "TNDS"
+//
+// El pie permite leer solo las columnas y rangos de filas necesarios, y las
+// estadísticas min/max de cada trozo permiten saltar trozos enteros al filtrar.
+
+enum DatasetColumn {
+    DATASET_ORIGIN_X,
+    DATASET_ORIGIN_Y,
+    DATASET_ORIGIN_Z,
+    DATASET_SPEED,
+    DATASET_ANGLE,
+    DATASET_ELEVATION,
+    DATASET_SPIN_X,
+    DATASET_SPIN_Z,
+    DATASET_LANDING_X,          // NaN si la pelota no bota
+    DATASET_LANDING_Z,
+    DATASET_NET_CLEARANCE,      // NaN si no llega a la red
+    DATASET_FLIGHT_TIME,        // NaN si la pelota no bota
+    DATASET_COLUMN_COUNT
+};
+
+// Nombre de cada columna tal como se guarda en el pie
+const char* GetDatasetColumnName(int column);
+
+// Entrada del índice del pie: dónde está una columna de un trozo y qué contiene
+struct DatasetChunkInfo {
+    uint64_t offset;        // Posición en el archivo del primer valor
+    uint32_t rows;
+    uint32_t nanCount;      // Valores NaN (no cuentan para min/max)
+    float min;              // NaN si todos los valores son NaN
+    float max;
+};
+
+static_assert(sizeof(DatasetChunkInfo) == 24, "DatasetChunkInfo se escribe tal cual en el pie");
+
+// Escritor en streaming: las filas se acumulan en un búfer por columna y cada
+// trozo completo se escribe con una escritura secuencial grande por columna.
+// Se escribe en "<path>.part" y solo Close() lo renombra a 'path', así que en
+// 'path' nunca hay un dataset a medias.
+class TrajectoryDatasetWriter {
+private:
+    FILE* file = nullptr;
+    std::string path;                                       // Destino final
+    std::string partPath;                                   // Archivo temporal mientras se escribe
+    std::vector<char> fileBuffer;                           // Búfer de stdio (evita escrituras pequeñas)
+    std::vector<float> columns[DATASET_COLUMN_COUNT];       // Trozo en curso
+    std::vector<DatasetChunkInfo> index;                    // Un DatasetChunkInfo por columna y trozo
+    uint32_t chunkRows;
+    uint64_t totalRows = 0;
+    uint64_t offset = 0;
+    bool failed = false;
+
+    bool WriteBytes(const void* data, size_t size);
+    void FlushChunk();
+
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t DEFAULT_CHUNK_ROWS = 16384;      // 64 KB por columna y trozo
+
+    explicit TrajectoryDatasetWriter(uint32_t chunkRows = DEFAULT_CHUNK_ROWS);
+    ~TrajectoryDatasetWriter();
+
+    TrajectoryDatasetWriter(const TrajectoryDatasetWriter&) = delete;
+    TrajectoryDatasetWriter& operator=(const TrajectoryDatasetWriter&) = delete;
+
+    bool Open(const char* path);
+    void Append(const ShotParams& shot, const ShotSummary& summary);
+    // Escribe el último trozo y el pie, cierra el archivo y lo renombra a 'path'.
+    // Devuelve false si hubo algún error (y entonces borra el archivo temporal).
+    bool Close();
+    // Cierra y borra el archivo temporal: un dataset interrumpido no deja nada en
+    // el sistema de archivos. El destructor también aborta si no se ha llamado a Close().
+    void Abort();
+
+    bool IsOpen() const { return file != nullptr; }
+    uint64_t GetRowCount() const { return totalRows; }
+};
+
+// Lector: carga solo el pie y lee columnas o rangos de filas bajo demanda
+class TrajectoryDatasetReader {
+private:
+    FILE* file = nullptr;
+    std::vector<DatasetChunkInfo> index;
+    std::vector<char> names;                    // columnCount × 16 caracteres
+    uint32_t columnCount = 0;
+    uint32_t chunkRows = 0;
+    uint32_t chunkCount = 0;
+    uint64_t totalRows = 0;
+
+public:
+    TrajectoryDatasetReader() = default;
+    ~TrajectoryDatasetReader();
+
+    TrajectoryDatasetReader(const TrajectoryDatasetReader&) = delete;
+    TrajectoryDatasetReader& operator=(const TrajectoryDatasetReader&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+
+    uint64_t GetRowCount() const { return totalRows; }
+    uint32_t GetChunkCount() const { return chunkCount; }
+    uint32_t GetChunkRows() const { return chunkRows; }
+    int FindColumn(const char* name) const;     // -1 si no existe
+    const DatasetChunkInfo& GetChunkInfo(int column, uint32_t chunk) const {
+        return index[(size_t)chunk * columnCount + column];
+    }
+
+    // Lee count filas de una columna a partir de firstRow. Devuelve las filas leídas.
+    uint64_t ReadColumn(int column, uint64_t firstRow, uint64_t count, float* out) const;
+};
+
+#endif // TRAJECTORY_DATASET_H
@@ -0,0 +1,45 @@
+#include "TrajectoryDatasetJob.h"
+#include "Log.h"
+
+TrajectoryDatasetJob::TrajectoryDatasetJob(const ShotParams& baseShot, const Court& court, float ballRadius,
+                                           float minSpeed, float maxSpeed, int speedSteps, const char* path)
+    : baseShot(baseShot), court(court), ballRadius(ballRadius), minSpeed(minSpeed),
+      speedStep(speedSteps > 1 ? (maxSpeed - minSpeed) / (speedSteps - 1) : 0.0f),
+      speedSteps(speedSteps > 0 ? speedSteps : 1), path(path) {}
+
+bool TrajectoryDatasetJob::RunSlice(JobContext& context) {
+    // El archivo se abre en el primer trozo, ya en el hilo del trabajo
+    if (row == 0 && column == 0 && !writer.IsOpen() && !writer.Open(path.c_str())) {
+        LOG_ERROR("Dataset de trayectorias: no se pudo abrir el archivo");
+        context.Fail();
+        return true;
+    }
+
+    ShotParams shot = baseShot;
+    shot.speed = minSpeed + (row / ShotSweep::GetElevationCount()) * speedStep;
+    shot.elevationDeg = ShotSweep::GetElevation(row % ShotSweep::GetElevationCount());
+    for (; column < ShotSweep::GetAngleCount(); column++) {
+        if (context.ShouldYield()) {
+            if (context.IsCancelled()) {
+                writer.Abort();  // Borra el archivo a medias
+                return true;
+            }
+            return false;  // Presupuesto agotado: el siguiente trozo sigue en este ángulo
+        }
+        shot.angleDeg = ShotSweep::GetAngle(column);
+        writer.Append(shot, SimulateShotSummary(shot, court, ballRadius));
+    }
+
+    row++;
+    column = 0;
+    context.ReportProgress((float)row / GetRowCount());
+    if (row < GetRowCount()) {
+        return false;
+    }
+
+    if (!writer.Close()) {
+        LOG_ERROR("Dataset de trayectorias incompleto");
+        context.Fail();
+    }
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef TRAJECTORY_DATASET_JOB_H
+#define TRAJECTORY_DATASET_JOB_H
+
+#include "JobScheduler.h"
+#include "TrajectoryDataset.h"
+#include "ShotSweep.h"
+#include <string>
+
+// Simulación por lotes que recorre velocidad × elevación × ángulo y escribe el
+// resumen de cada golpe en un dataset columnar (ángulos y elevaciones de
+// ShotSweep). Cada trozo simula como mucho una fila de ángulos (una velocidad y
+// una elevación) y se corta antes si se agota el presupuesto del frame. El archivo solo aparece en 'path' cuando el trabajo
+// termina; si se cancela o falla, el escritor borra el archivo temporal.
+class TrajectoryDatasetJob : public Job {
+private:
+    ShotParams baseShot;        // Origen y spin comunes a todo el lote
+    Court court;                // Copia: el trabajo no comparte estado con el hilo principal
+    float ballRadius;
+    float minSpeed;
+    float speedStep;
+    int speedSteps;
+    std::string path;
+    TrajectoryDatasetWriter writer;
+    int row = 0;                // Fila actual: row = speedIndex * elevaciones + elevationIndex
+    int column = 0;             // Siguiente ángulo de la fila actual
+
+public:
+    TrajectoryDatasetJob(const ShotParams& baseShot, const Court& court, float ballRadius,
+                         float minSpeed, float maxSpeed, int speedSteps, const char* path);
+
+    int GetRowCount() const { return speedSteps * ShotSweep::GetElevationCount(); }
+    bool RunSlice(JobContext& context) override;
+};
+
+#endif // TRAJECTORY_DATASET_JOB_H
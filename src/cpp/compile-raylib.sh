@@ -45,6 +45,12 @@ COMMON_FLAGS=(
     -I..
 )
 
+# Con hilos (THREADS=1, por defecto en compile.sh) todos los objetos enlazados
+# deben compilarse con -pthread
+if [ "${THREADS:-1}" = "1" ]; then
+    COMMON_FLAGS+=(-pthread)
+fi
+
 # Compilar cada archivo .c
 for f in "${FILES[@]}"; do
     echo "  → Compilando $f"
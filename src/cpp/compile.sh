@@ -62,12 +62,28 @@ fi
 SRC_DIR="$(cd "$(dirname "$0")" && pwd)"
 BUILD_DIR="$SRC_DIR/../../public/cpp"
 TARGET="tennis_emulator"
+SOURCES=(main.cpp Court.cpp Log.cpp TrajectoryCache.cpp JobScheduler.cpp ClearanceHeatmap.cpp TrajectoryDataset.cpp TrajectoryDatasetJob.cpp InputBridge.cpp QualityGovernor.cpp)
+
+# Nivel mínimo de log compilado (0=debug, 1=info, 2=warn, 3=error, 4=ninguno)
+LOG_LEVEL=${LOG_LEVEL:-1}
+
+# Perfil de compilación:
+#   startup - arranque rápido: sin Asyncify, heap inicial pequeño, solo entorno web
+#   compat  - configuración anterior (Asyncify y heap inicial de 64 MB)
+BUILD_PROFILE=${BUILD_PROFILE:-startup}
+
+# Hilos para los trabajos de análisis (necesita SharedArrayBuffer, es decir,
+# los headers COOP/COEP de vite.config.ts). Con THREADS=0 los trabajos se
+# ejecutan por trozos en el hilo principal con un presupuesto por frame.
+THREADS=${THREADS:-1}
+JOB_WORKERS=2
 
 # Crear directorio de salida
 mkdir -p "$BUILD_DIR"
 
 echo "📂 Directorio fuente: $SRC_DIR"
 echo "📂 Directorio de salida: $BUILD_DIR"
+echo "⚙️  Perfil: $BUILD_PROFILE (hilos: $THREADS)"
 echo ""
 
 # Flags de compilación básicos
@@ -76,12 +92,11 @@ FLAGS=(
     -s USE_GLFW=3
     -s USE_WEBGL2=1
     -s GL_PREINITIALIZED_CONTEXT=0
-    -s ASYNCIFY
     -s ALLOW_MEMORY_GROWTH=1
-    -s INITIAL_MEMORY=67108864
     -s MODULARIZE=1
     -s EXPORT_NAME="createTennisEmulatorModule"
-    -s EXPORTED_FUNCTIONS="['_main','_shootBall','_setBallAngle','_malloc','_free']"
+    -s EXPORTED_FUNCTIONS="['_main','_shootBall','_shootBallFromCurrentPosition','_setSimulationPaused','_rewindSimulation','_getSimulationTick','_getSimulationBranchCount','_getSimulationBranch','_selectSimulationBranch','_setBallAngle','_getTrajectoryCacheStats','_setTrajectoryCacheBudget','_setCourtPhysics','_startClearanceHeatmap','_getClearanceHeatmapColumns','_getClearanceHeatmapRows','_startTrajectoryDataset','_cancelJob','_setInputForwarding','_forwardMouseMove','_forwardMouseButton','_forwardMouseWheel','_forwardKey','_getQualityLevelCount','_getQualityLevel','_setQualityLevel','_malloc','_free']"
+    -s EXPORTED_RUNTIME_METHODS="['FS','ccall']"
     -s USE_GLFW=3
     -s USE_WEBGL2=1
     -s FULL_ES3=1
@@ -89,8 +104,41 @@ FLAGS=(
     -s MAX_WEBGL_VERSION=2
     -O2
     -DPLATFORM_WEB
+    -DTENNIS_LOG_LEVEL=$LOG_LEVEL
 )
 
+if [ "$THREADS" = "1" ]; then
+    FLAGS+=(
+        -pthread
+        -s PTHREAD_POOL_SIZE=$JOB_WORKERS
+        -DTENNIS_JOB_WORKERS=$JOB_WORKERS
+    )
+fi
+
+case "$BUILD_PROFILE" in
+    startup)
+        # El bucle principal ya usa callbacks (emscripten_set_main_loop), así que
+        # Asyncify no es necesario y solo añade tamaño y tiempo de compilación.
+        # El heap crece bajo demanda desde 16 MB en lugar de reservar 64 MB al inicio.
+        # El entorno worker permite cargar el módulo en public/tennis-worker.js.
+        FLAGS+=(
+            -s INITIAL_MEMORY=16777216
+            -s ENVIRONMENT=web,worker
+            -s WASM_ASYNC_COMPILATION=1
+        )
+        ;;
+    compat)
+        FLAGS+=(
+            -s ASYNCIFY
+            -s INITIAL_MEMORY=67108864
+        )
+        ;;
+    *)
+        echo "❌ Perfil desconocido: $BUILD_PROFILE (usa startup o compat)"
+        exit 1
+        ;;
+esac
+
 # Si tenemos raylib, verificar si está compilado y compilarlo si es necesario
 if [ ! -z "$RAYLIB_PATH" ] && [ -d "$RAYLIB_PATH/src" ]; then
     RAYLIB_LIB="$RAYLIB_PATH/src/libraylib.a"
@@ -156,7 +204,7 @@ echo "   Flags: ${FLAGS[*]}"
 cd "$SRC_DIR"
 
 # Compilar y capturar el código de salida correctamente
-if emcc main.cpp Court.cpp "${FLAGS[@]}" -o "$BUILD_DIR/$TARGET.js" 2>&1 | tee /tmp/emcc_output.log; then
+if emcc "${SOURCES[@]}" "${FLAGS[@]}" -o "$BUILD_DIR/$TARGET.js" 2>&1 | tee /tmp/emcc_output.log; then
     echo ""
     echo "✅ Compilación exitosa!"
     echo "   Archivos generados en: $BUILD_DIR"
@@ -1,37 +1,23 @@
 #ifdef PLATFORM_WEB
     #include <emscripten/emscripten.h>
-    #include <cstdio>
-    #include <cstdarg>
-    #include <string>
-    
-    // Función helper para hacer console.log desde C++ (soporta formato como printf)
-    inline void console_log(const char* format, ...) {
-        char buffer[512];
-        va_list args;
-        va_start(args, format);
-        vsnprintf(buffer, sizeof(buffer), format, args);
-        va_end(args);
-        std::string script = "console.log('";
-        script += buffer;
-        script += "');";
-        emscripten_run_script(script.c_str());
-    }
 #else
-    // Para plataformas no-web, usar printf normal
-    #include <cstdio>
-    #include <cstdarg>
-    inline void console_log(const char* format, ...) {
-        va_list args;
-        va_start(args, format);
-        vprintf(format, args);
-        va_end(args);
-        printf("\n");
-    }
+    #define EMSCRIPTEN_KEEPALIVE
+    #include <chrono>
 #endif
 
 #include "raylib.h"
 #include "Ball3d.h"
 #include "Court.h"
+#include "Log.h"
+#include "InputBridge.h"
+#include "TrajectoryCache.h"
+#include "JobScheduler.h"
+#include "ClearanceHeatmap.h"
+#include "SimulationHistory.h"
+#include "TrajectoryDatasetJob.h"
+#include "QualityGovernor.h"
+#include <memory>
+#include <vector>
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
@@ -67,31 +53,345 @@ float ballInitialElevation = -20.0f; // Ángulo vertical (en grados, negativo =
 Vector3 ballInitialSpin = {20.0f, 0.0f, -10.0f};
 Ball3D pelota({0.0f, 50.0f, 50.0f}, 15.0f, RED, {0.0f, 0.0f, 0.0f}); // Empieza sin movimiento
 
+// Caché de trayectorias: los golpes repetidos se reproducen en lugar de simularse de nuevo
+const size_t TRAJECTORY_CACHE_BUDGET = 4 * 1024 * 1024;  // 4 MB
+TrajectoryCache trajectoryCache(TRAJECTORY_CACHE_BUDGET);
+TrajectoryPlayer shotPlayer;
+
+// Simulación con paso fijo: la misma secuencia de ticks da siempre el mismo
+// resultado, así que rebobinar y volver a simular es determinista
+const float SIM_TICK = 1.0f / 60.0f;
+const float MAX_FRAME_TIME = 0.25f;         // Evita encadenar muchos ticks tras un parón del navegador
+const uint32_t HISTORY_TICKS = 10 * 60;     // 10 s de instantáneas (~52 bytes cada una), repartidos entre las ramas
+SimulationHistory history(HISTORY_TICKS);
+float simAccumulator = 0.0f;
+uint32_t simTick = 0;
+bool simPaused = false;
+uint32_t currentShotSerial = 0;             // Último golpe lanzado en la tabla del historial (0 = ninguno)
+uint32_t notifiedBranchCount = 0;           // Ramas del historial que conoce JS
+uint32_t notifiedActiveBranch = 0;
+
+// Eventos de la simulación del frame (botes, red, parada). Se entregan a JS en
+// un único lote al final del frame; time = segundos de simulación (tick * SIM_TICK)
+const uint32_t FRAME_EVENT_CAPACITY = 256;
+SimEventQueue frameEvents(FRAME_EVENT_CAPACITY);
+
+// Trabajos de análisis en segundo plano. Se crea en main() para que los hilos
+// no arranquen durante la inicialización estática del módulo
+std::unique_ptr<JobScheduler> jobScheduler;
+std::vector<JobUpdate> jobUpdates;
+JobId heatmapJob = 0;
+const double JOB_FRAME_BUDGET_MS = 4.0;  // Solo sin hilos: tiempo de trabajo por frame
+
+// Calidad adaptativa: el regulador baja el detalle cuando los frames se pasan
+// del presupuesto de 60 FPS. Con renderScale < 1 la escena 3D se dibuja en una
+// textura más pequeña que luego se escala a la ventana.
+QualityGovernor qualityGovernor(60);
+RenderTexture2D sceneTarget = {};
+bool sceneTargetLoaded = false;
+
+// Instrumentación de arranque: marcas de tiempo en ms (en web, el mismo reloj que performance.now())
+double startupMainMs = 0.0;
+double startupInitWindowMs = 0.0;
+bool firstFrameReported = false;
+
 // Funciones
 void UpdateDrawFrame(void);
 void UpdateCameraControls(void);
 Vector3 CalculateCameraPosition(Vector3 target, float distance, float angleX, float angleY);
 
-// Función auxiliar para calcular velocidad desde ángulo y velocidad
-Vector3 CalculateVelocityFromAngle(float speed, float angleDeg, float elevationDeg) {
-    // Convertir grados a radianes
-    float angleRad = angleDeg * M_PI / 180.0f;
-    float elevationRad = elevationDeg * M_PI / 180.0f;
-    
-    // Calcular componentes de velocidad
-    float velX = speed * cosf(elevationRad) * sinf(angleRad);
-    float velY = speed * sinf(elevationRad);
-    float velZ = speed * cosf(elevationRad) * cosf(angleRad);
-    
-    return {velX, velY, velZ};
+double NowMs() {
+#ifdef PLATFORM_WEB
+    return emscripten_get_now();
+#else
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+#ifdef PLATFORM_WEB
+// Entrega las marcas de arranque a JS a través de Module.onStartupMetrics (si está definido)
+EM_JS(void, tennis_report_startup, (double mainStart, double initWindowEnd, double firstFrameEnd), {
+    if (typeof Module['onStartupMetrics'] === 'function') {
+        Module['onStartupMetrics']({ mainStart: mainStart, initWindowEnd: initWindowEnd, firstFrameEnd: firstFrameEnd });
+    }
+});
+#endif
+
+void ReportStartupMetrics(double firstFrameEndMs) {
+    LOG_INFO("Arranque (ms): InitWindow, primer frame", startupInitWindowMs - startupMainMs, firstFrameEndMs - startupMainMs);
+#ifdef PLATFORM_WEB
+    tennis_report_startup(startupMainMs, startupInitWindowMs, firstFrameEndMs);
+#endif
+}
+
+#ifdef PLATFORM_WEB
+// Entrega una notificación de trabajo a JS a través de Module.onJobUpdate (si está definido)
+EM_JS(void, tennis_job_update, (int id, int type, float progress, int offset, const float* values, int count), {
+    if (typeof Module['onJobUpdate'] !== 'function') {
+        return;
+    }
+    const types = ['progress', 'partial', 'done', 'cancelled', 'failed'];
+    Module['onJobUpdate']({
+        id: id,
+        type: types[type],
+        progress: progress,
+        offset: offset,
+        values: HEAPF32.slice(values >> 2, (values >> 2) + count)
+    });
+});
+#endif
+
+// Avanza los trabajos (sin hilos) y envía sus notificaciones del frame a JS
+void DeliverJobUpdates() {
+    if (!jobScheduler) return;
+    jobScheduler->Pump(JOB_FRAME_BUDGET_MS);
+    jobScheduler->Drain(jobUpdates);
+    for (const JobUpdate& update : jobUpdates) {
+#ifdef PLATFORM_WEB
+        tennis_job_update(update.id, update.type, update.progress, update.offset,
+                          update.values.data(), (int)update.values.size());
+#endif
+        if (update.type == JobUpdate::Done || update.type == JobUpdate::Cancelled) {
+            LOG_DEBUG(update.type == JobUpdate::Done ? "Trabajo terminado" : "Trabajo cancelado", update.id);
+            if (update.id == heatmapJob) heatmapJob = 0;
+        } else if (update.type == JobUpdate::Failed) {
+            LOG_WARN("Trabajo fallido", update.id);
+            if (update.id == heatmapJob) heatmapJob = 0;
+        }
+    }
+}
+
+#ifdef PLATFORM_WEB
+// Avisa a JS de un cambio de nivel de calidad a través de Module.onQualityChange (si está definido)
+EM_JS(void, tennis_quality_change, (int level, int automatic, float renderScale), {
+    if (typeof Module['onQualityChange'] === 'function') {
+        Module['onQualityChange']({ level: level, automatic: automatic !== 0, renderScale: renderScale });
+    }
+});
+#endif
+
+// Aplica los parámetros del nivel de calidad actual a la pista, la pelota y el render
+void ApplyQuality() {
+    const QualitySettings& settings = qualityGovernor.GetSettings();
+    CourtDetail detail;
+    detail.netVerticalLines = settings.netVerticalLines;
+    detail.netHorizontalLines = settings.netHorizontalLines;
+    detail.netHorizontalSegments = settings.netHorizontalSegments;
+    detail.bandSegments = settings.bandSegments;
+    court.SetDetail(detail);
+    pelota.SetDrawDetail(settings.trailPoints, settings.sphereRings, settings.sphereSlices);
+
+    if (sceneTargetLoaded) {
+        UnloadRenderTexture(sceneTarget);
+        sceneTargetLoaded = false;
+    }
+    if (settings.renderScale < 1.0f) {
+        sceneTarget = LoadRenderTexture((int)(screenWidth * settings.renderScale), (int)(screenHeight * settings.renderScale));
+        SetTextureFilter(sceneTarget.texture, TEXTURE_FILTER_BILINEAR);
+        sceneTargetLoaded = true;
+    }
+
+    LOG_INFO("Nivel de calidad:", qualityGovernor.GetLevel());
+#ifdef PLATFORM_WEB
+    tennis_quality_change(qualityGovernor.GetLevel(), qualityGovernor.IsAutomatic() ? 1 : 0, settings.renderScale);
+#endif
+}
+
+#ifdef PLATFORM_WEB
+// Entrega los eventos del frame a JS a través de Module.onSimulationEvents (si está definido).
+// data es una copia de los registros de 28 bytes (ver SimEvent en SimulationEvents.h)
+EM_JS(void, tennis_simulation_events, (const void* events, int count, int dropped), {
+    if (typeof Module['onSimulationEvents'] !== 'function') {
+        return;
+    }
+    Module['onSimulationEvents']({
+        count: count,
+        dropped: dropped,
+        data: HEAPU8.slice(events, events + count * 28).buffer
+    });
+});
+#endif
+
+// Envía a JS el lote de eventos del frame y vacía la cola
+void DeliverSimulationEvents() {
+    if (frameEvents.GetCount() == 0 && frameEvents.GetDropped() == 0) return;
+    if (frameEvents.GetDropped() > 0) {
+        LOG_WARN("Eventos de simulación descartados:", frameEvents.GetDropped());
+    }
+#ifdef PLATFORM_WEB
+    tennis_simulation_events(frameEvents.GetData(), (int)frameEvents.GetCount(), (int)frameEvents.GetDropped());
+#endif
+    frameEvents.Clear();
+}
+
+SimulationSnapshot CaptureSnapshot() {
+    float shotTime = shotPlayer.IsActive() ? shotPlayer.GetTime() : -1.0f;
+    return {pelota.GetState(), simTick, currentShotSerial, shotTime};
+}
+
+// Reconstruye la estela de la última instantánea del historial tal como se vio en
+// directo: LaunchShot deja solo el origen del golpe y Ball3D añade un punto por
+// cada tick que empieza con la pelota en movimiento. Así que cuentan los ticks
+// del mismo golpe en los que la pelota venía moviéndose (o el primero tras el
+// lanzamiento) y, si se llega al lanzamiento, el origen. Escribe los puntos del
+// más antiguo al más reciente y devuelve cuántos hay.
+int RebuildTrail(Vector3* trail) {
+    const int maxPoints = Ball3D::GetMaxTrailPoints();
+    const uint32_t count = history.GetCount();
+    const uint32_t shotSerial = history.Get(0).shotSerial;
+    Vector3 newestFirst[Ball3D::GetMaxTrailPoints()];
+    int points = 0;
+    bool reachedLaunch = false;
+    for (uint32_t k = 0; k < count && points < maxPoints; k++) {
+        const SimulationSnapshot& snapshot = history.Get(k);
+        if (snapshot.shotSerial != shotSerial) break;
+        bool firstOfShot = k + 1 == count || history.Get(k + 1).shotSerial != shotSerial;
+        if (firstOfShot || history.Get(k + 1).ball.body.isMoving) {
+            newestFirst[points++] = snapshot.ball.GetPosition();
+        }
+        // El primer tick de un golpe reproducido tiene shotTime == SIM_TICK exacto,
+        // aunque la instantánea del lanzamiento ya haya salido del historial
+        reachedLaunch = firstOfShot && (k + 1 < count || snapshot.shotTime == SIM_TICK);
+    }
+
+    Vector3 origin;
+    if (reachedLaunch && points < maxPoints && history.GetShotOrigin(shotSerial, origin)) {
+        newestFirst[points++] = origin;
+    }
+    for (int i = 0; i < points; i++) {
+        trail[i] = newestFirst[points - 1 - i];
+    }
+    return points;
+}
+
+// Vuelve al estado de la última instantánea del historial en O(1): la estela se
+// reconstruye con las instantáneas anteriores y la trayectoria se comparte por puntero.
+// Continuar un golpe exactamente igual requiere que siga en la tabla de golpes del
+// historial (los 64 últimos); si ya no está, la pelota sigue con la física en directo
+// desde la posición y la velocidad guardadas.
+void RestoreSnapshot(const SimulationSnapshot& snapshot) {
+    Vector3 trail[Ball3D::GetMaxTrailPoints()];
+    int trailCount = RebuildTrail(trail);
+    pelota.Restore(snapshot.ball, trail, trailCount);
+
+    std::shared_ptr<const Trajectory> shot = history.GetShot(snapshot.shotSerial);
+    if (shot && snapshot.shotTime >= 0.0f) {
+        shotPlayer.Seek(shot, snapshot.shotTime);
+    } else {
+        shotPlayer.Stop();
+    }
+    currentShotSerial = snapshot.shotSerial;
+    simTick = snapshot.tick;
+    simAccumulator = 0.0f;
+}
+
+#ifdef PLATFORM_WEB
+// Avisa a JS de un cambio en las ramas del historial a través de Module.onBranchChange (si está definido)
+EM_JS(void, tennis_branch_change, (int count, int active), {
+    if (typeof Module['onBranchChange'] === 'function') {
+        Module['onBranchChange']({ count: count, active: active });
+    }
+});
+#endif
+
+// Avisa a JS si ha cambiado el número de ramas o la rama activa
+void NotifyBranches() {
+    if (history.GetBranchCount() == notifiedBranchCount && history.GetActiveBranch() == notifiedActiveBranch) return;
+    notifiedBranchCount = history.GetBranchCount();
+    notifiedActiveBranch = history.GetActiveBranch();
+#ifdef PLATFORM_WEB
+    tennis_branch_change((int)notifiedBranchCount, (int)notifiedActiveBranch);
+#endif
+}
+
+// Avanza la simulación un tick y guarda la instantánea resultante
+void StepSimulation() {
+    float tickTime = (simTick + 1) * SIM_TICK;
+
+    // Actualizar la pelota: reproducir el golpe en curso o simular (solo si está en movimiento)
+    if (shotPlayer.IsActive()) {
+        // Los eventos del golpe ya están en la trayectoria: se emiten los de este
+        // intervalo de reproducción, pasados a tiempo de simulación
+        std::shared_ptr<const Trajectory> shot = shotPlayer.GetTrajectory();
+        float shotStart = shotPlayer.GetTime();
+        Vector3 shotPosition;
+        bool moving = shotPlayer.Advance(SIM_TICK, shotPosition);
+        float shotEnd = moving ? shotStart + SIM_TICK : INFINITY;  // Al terminar, todos los que queden
+        for (const SimEvent& event : shot->events) {
+            if (event.time > shotStart && event.time <= shotEnd) {
+                SimEvent frameEvent = event;
+                frameEvent.time = tickTime - SIM_TICK + (event.time - shotStart);
+                frameEvents.Push(frameEvent);
+            }
+        }
+        pelota.Follow(shotPosition, moving, SIM_TICK);
+    } else {
+        float netZ = court.GetMaxZ() / 2.0f;  // Centro de la pista (donde está la red)
+        pelota.Update(SIM_TICK, court.GetFloorY(), court.GetMaxX(), court.GetMaxZ(), netZ, court, &frameEvents, tickTime);
+    }
+    simTick++;
+    history.Record(CaptureSnapshot());
+    NotifyBranches();
+}
+
+// Lanza un golpe desde origin con el ángulo, velocidad y spin configurados
+void LaunchShot(Vector3 origin) {
+    ShotParams shot = {origin, ballInitialSpeed, ballInitialAngle, ballInitialElevation, ballInitialSpin};
+    uint32_t missesBefore = trajectoryCache.GetStats().misses;
+    std::shared_ptr<const Trajectory> trajectory = trajectoryCache.GetOrSimulate(shot, court, pelota.GetRadius());
+    currentShotSerial = history.AddShot(trajectory, origin);
+    shotPlayer.Start(std::move(trajectory));
+    pelota.Reset(origin, {0.0f, 0.0f, 0.0f}, ballInitialSpin);
+    simPaused = false;
+    LOG_DEBUG(trajectoryCache.GetStats().misses == missesBefore ? "Trayectoria desde caché" : "Trayectoria simulada");
 }
 
 // Función exportada para disparar la pelota desde JavaScript
 extern "C" {
     void EMSCRIPTEN_KEEPALIVE shootBall() {
-        Vector3 vel = CalculateVelocityFromAngle(ballInitialSpeed, ballInitialAngle, ballInitialElevation);
-        pelota.Reset(ballInitialPos, vel, ballInitialSpin);
+        LaunchShot(ballInitialPos);
+    }
+
+    // Golpe alternativo desde donde está ahora la pelota (p. ej. tras rebobinar)
+    void EMSCRIPTEN_KEEPALIVE shootBallFromCurrentPosition() {
+        LaunchShot(pelota.GetPosition());
+    }
+
+    void EMSCRIPTEN_KEEPALIVE setSimulationPaused(int paused) {
+        simPaused = paused != 0;
+        simAccumulator = 0.0f;
+    }
+
+    // Rebobina ms milisegundos (hasta lo que haya en el historial) y pausa la
+    // simulación. Devuelve los milisegundos rebobinados realmente. Lo que se simule
+    // después abre una rama nueva; la actual se conserva (selectSimulationBranch).
+    int EMSCRIPTEN_KEEPALIVE rewindSimulation(int ms) {
+        uint32_t ticks = ms > 0 ? (uint32_t)lroundf(ms / 1000.0f / SIM_TICK) : 0;
+        uint32_t tickBefore = simTick;
+        const SimulationSnapshot* snapshot = history.Rewind(ticks);
+        if (snapshot) {
+            RestoreSnapshot(*snapshot);
+        }
+        simPaused = true;
+        return (int)lroundf((tickBefore - simTick) * SIM_TICK * 1000.0f);
     }
+
+    // Ramas del historial (rebobinar y seguir simulando abre una; la rama activa es
+    // la del estado actual)
+    int EMSCRIPTEN_KEEPALIVE getSimulationBranchCount() { return (int)history.GetBranchCount(); }
+    int EMSCRIPTEN_KEEPALIVE getSimulationBranch() { return (int)history.GetActiveBranch(); }
+
+    // Salta al último instante de una rama y pausa. Devuelve 0 si la rama no existe
+    int EMSCRIPTEN_KEEPALIVE selectSimulationBranch(int branch) {
+        const SimulationSnapshot* snapshot = branch >= 0 ? history.SelectBranch((uint32_t)branch) : nullptr;
+        if (!snapshot) return 0;
+        RestoreSnapshot(*snapshot);
+        simPaused = true;
+        NotifyBranches();
+        return 1;
+    }
+
+    int EMSCRIPTEN_KEEPALIVE getSimulationTick() { return (int)simTick; }
     
     // Función para configurar el ángulo y velocidad inicial
     void EMSCRIPTEN_KEEPALIVE setBallAngle(float angleDeg, float elevationDeg, float speed) {
@@ -99,11 +399,85 @@ extern "C" {
         ballInitialElevation = elevationDeg;
         ballInitialSpeed = speed;
     }
+
+    // Contadores de la caché de trayectorias (hits, misses, evictions, entries, bytes, budgetBytes)
+    const TrajectoryCacheStats* EMSCRIPTEN_KEEPALIVE getTrajectoryCacheStats() {
+        return &trajectoryCache.GetStats();
+    }
+
+    void EMSCRIPTEN_KEEPALIVE setTrajectoryCacheBudget(int bytes) {
+        trajectoryCache.SetBudget(bytes > 0 ? (size_t)bytes : 0);
+    }
+
+    // Perfil físico de la pista. Afecta a la pelota, a los golpes nuevos (el perfil
+    // forma parte de la clave de la caché) y a los trabajos que se lancen después
+    void EMSCRIPTEN_KEEPALIVE setCourtPhysics(float gravity, float restitution, float frictionXZ, float minVelocity) {
+        PhysicsProfile profile;
+        profile.gravity = gravity;
+        profile.restitution = restitution;
+        profile.frictionXZ = frictionXZ;
+        profile.minVelocity = minVelocity;
+        court.SetPhysics(profile);
+    }
+
+    // Lanza el mapa de margen sobre la red (ángulo × elevación) para una velocidad.
+    // Cancela el mapa anterior si aún no había terminado. Devuelve el id del trabajo.
+    int EMSCRIPTEN_KEEPALIVE startClearanceHeatmap(float speed, int priority) {
+        if (!jobScheduler) return 0;
+        if (heatmapJob) {
+            jobScheduler->Cancel(heatmapJob);
+        }
+        ShotParams base = {ballInitialPos, speed, 0.0f, 0.0f, ballInitialSpin};
+        heatmapJob = jobScheduler->Submit(std::make_unique<ClearanceHeatmapJob>(base, court, pelota.GetRadius()), priority);
+        return heatmapJob;
+    }
+
+    int EMSCRIPTEN_KEEPALIVE getClearanceHeatmapColumns() { return ClearanceHeatmapJob::GetColumns(); }
+    int EMSCRIPTEN_KEEPALIVE getClearanceHeatmapRows() { return ClearanceHeatmapJob::GetRows(); }
+
+    // Lanza una simulación por lotes (velocidad × elevación × ángulo) que escribe un
+    // dataset columnar en path. En la web el archivo queda en el sistema de archivos
+    // en memoria: Module.FS.readFile(path) cuando llegue la notificación "done".
+    int EMSCRIPTEN_KEEPALIVE startTrajectoryDataset(const char* path, float minSpeed, float maxSpeed, int speedSteps, int priority) {
+        if (!jobScheduler || !path) return 0;
+        ShotParams base = {ballInitialPos, minSpeed, 0.0f, 0.0f, ballInitialSpin};
+        return jobScheduler->Submit(std::make_unique<TrajectoryDatasetJob>(base, court, pelota.GetRadius(),
+                                                                           minSpeed, maxSpeed, speedSteps, path), priority);
+    }
+
+    void EMSCRIPTEN_KEEPALIVE cancelJob(int id) {
+        if (jobScheduler) jobScheduler->Cancel(id);
+    }
+
+    // Entrada reenviada desde el hilo principal (modo worker con OffscreenCanvas)
+    void EMSCRIPTEN_KEEPALIVE setInputForwarding(int enabled) {
+        Input::SetForwarding(enabled != 0);
+        lastMousePos = Input::GetMousePosition();
+    }
+
+    void EMSCRIPTEN_KEEPALIVE forwardMouseMove(float x, float y) { Input::ForwardMouseMove(x, y); }
+    void EMSCRIPTEN_KEEPALIVE forwardMouseButton(int button, int down) { Input::ForwardMouseButton(button, down != 0); }
+    void EMSCRIPTEN_KEEPALIVE forwardMouseWheel(float delta) { Input::ForwardMouseWheel(delta); }
+    void EMSCRIPTEN_KEEPALIVE forwardKey(int key, int down) { Input::ForwardKey(key, down != 0); }
+
+    // Número de niveles de calidad (el último es la calidad original)
+    int EMSCRIPTEN_KEEPALIVE getQualityLevelCount() { return QualityGovernor::LEVEL_COUNT; }
+
+    // Nivel de calidad actual (0 = mínima, getQualityLevelCount() - 1 = original)
+    int EMSCRIPTEN_KEEPALIVE getQualityLevel() { return qualityGovernor.GetLevel(); }
+
+    // Fija el nivel de calidad; -1 vuelve al modo automático
+    void EMSCRIPTEN_KEEPALIVE setQualityLevel(int level) {
+        qualityGovernor.SetLevel(level);
+        ApplyQuality();
+    }
 }
 
 
 int main(void)
 {
+    startupMainMs = NowMs();
+
     // Inicializar semilla
     srand(time(nullptr));
 
@@ -112,24 +486,24 @@ int main(void)
 
     // Inicializar ventana
     InitWindow(screenWidth, screenHeight, "Simulador de Tenis 3D");
+    startupInitWindowMs = NowMs();
     
     // Verificar que la ventana se inicializó correctamente
     if (!IsWindowReady()) {
-        #ifdef PLATFORM_WEB
-        emscripten_run_script("console.error('[WASM] Error: Ventana no inicializada');");
-        #endif
+        LOG_ERROR("Error: Ventana no inicializada");
+        Log::Flush();
         return 1;
     }
     
     SetTargetFPS(60);
     
-    // Ejemplo de uso de console_log
-    console_log("Simulador de Tenis 3D inicializado");
-    console_log("Ancho de pista: %.2f unidades", COURT_WIDTH);
+    LOG_INFO("Simulador de Tenis 3D inicializado");
+    LOG_INFO("Ancho de pista (unidades):", COURT_WIDTH);
 
     // Inicializar posición inicial de la pelota
     ballInitialPos = {court.GetMaxX() / 2, 50.0f, 50.0f};
     pelota.Reset(ballInitialPos, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
+    history.Record(CaptureSnapshot());
     
     // Calcular velocidad inicial basada en ángulos
     Vector3 initialVel = CalculateVelocityFromAngle(ballInitialSpeed, ballInitialAngle, ballInitialElevation);
@@ -144,7 +518,10 @@ int main(void)
     camera.fovy = 70.0f;                              // campo de visión más amplio para ver mejor la profundidad
     camera.projection = CAMERA_PERSPECTIVE;
     
-    lastMousePos = GetMousePosition();
+    lastMousePos = Input::GetMousePosition();
+
+    jobScheduler = std::make_unique<JobScheduler>();
+    ApplyQuality();
 
 #ifdef PLATFORM_WEB
     emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
@@ -154,6 +531,9 @@ int main(void)
     }
 #endif
 
+    if (sceneTargetLoaded) {
+        UnloadRenderTexture(sceneTarget);
+    }
     CloseWindow();
     return 0;
 }
@@ -168,13 +548,13 @@ Vector3 CalculateCameraPosition(Vector3 target, float distance, float angleX, fl
 }
 
 void UpdateCameraControls(void) {
-    Vector2 mousePos = GetMousePosition();
+    Vector2 mousePos = Input::GetMousePosition();
     Vector2 mouseDelta = {mousePos.x - lastMousePos.x, mousePos.y - lastMousePos.y};
     
     // Shift + arrastrar: pan (mover el target) - tiene prioridad sobre la rotación
-    bool isShiftPressed = (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT));
+    bool isShiftPressed = (Input::IsKeyDown(KEY_LEFT_SHIFT) || Input::IsKeyDown(KEY_RIGHT_SHIFT));
     
-    if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
+    if (Input::IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
         if (!isMouseDragging) {
             isMouseDragging = true;
         } else if (isShiftPressed) {
@@ -235,7 +615,7 @@ void UpdateCameraControls(void) {
     }
     
     // Rueda del ratón: zoom (cambiar distancia)
-    float wheelMove = GetMouseWheelMove();
+    float wheelMove = Input::GetMouseWheelMove();
     if (wheelMove != 0.0f) {
         cameraDistance -= wheelMove * ZOOM_SENSITIVITY;
         if (cameraDistance < MIN_DISTANCE) cameraDistance = MIN_DISTANCE;
@@ -255,18 +635,30 @@ void UpdateDrawFrame(void)
         return;
     }
     
+    double frameStartMs = NowMs();
     float deltaTime = GetFrameTime();
 
     // Actualizar controles de cámara
     UpdateCameraControls();
 
-    // Actualizar la pelota (solo si está en movimiento)
-    float netZ = court.GetMaxZ() / 2.0f;  // Centro de la pista (donde está la red)
-    pelota.Update(deltaTime, court.GetFloorY(), court.GetMaxX(), court.GetMaxZ(), netZ, court);
+    // Simulación a paso fijo: tantos ticks como quepan en el tiempo transcurrido
+    if (!simPaused) {
+        simAccumulator += deltaTime < MAX_FRAME_TIME ? deltaTime : MAX_FRAME_TIME;
+        while (simAccumulator >= SIM_TICK) {
+            StepSimulation();
+            simAccumulator -= SIM_TICK;
+        }
+    }
 
-    // Dibujado
-    BeginDrawing();
-    ClearBackground(RAYWHITE);
+    // Dibujado: a resolución reducida en la textura intermedia (sin MSAA) o
+    // directamente en la ventana
+    if (sceneTargetLoaded) {
+        BeginTextureMode(sceneTarget);
+        ClearBackground(RAYWHITE);
+    } else {
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+    }
 
     BeginMode3D(camera);
 
@@ -278,9 +670,36 @@ void UpdateDrawFrame(void)
 
     EndMode3D();
 
-    // Texto informativo
+    if (sceneTargetLoaded) {
+        EndTextureMode();
+        BeginDrawing();
+        // Las texturas de render quedan invertidas en Y: altura negativa en el origen
+        Rectangle source = {0.0f, 0.0f, (float)sceneTarget.texture.width, -(float)sceneTarget.texture.height};
+        Rectangle dest = {0.0f, 0.0f, (float)screenWidth, (float)screenHeight};
+        DrawTexturePro(sceneTarget.texture, source, dest, {0.0f, 0.0f}, 0.0f, WHITE);
+    }
+
+    // Texto informativo (siempre a resolución completa)
     DrawText("Pelota de tenis 3D con rebote y spin!!!", 10, 10, 20, DARKGRAY);
     DrawText("Click izquierdo + arrastrar: Rotar | Rueda: Zoom | Shift + arrastrar: Pan", 10, 35, 16, DARKGRAY);
 
+    // El tiempo de trabajo no incluye EndDrawing, que en escritorio espera al objetivo de FPS
+    float workTime = (float)((NowMs() - frameStartMs) / 1000.0);
     EndDrawing();
+
+    if (qualityGovernor.Update(deltaTime, workTime)) {
+        ApplyQuality();
+    }
+
+    if (!firstFrameReported) {
+        firstFrameReported = true;
+        ReportStartupMetrics(NowMs());
+    }
+
+    Input::EndFrame();
+    DeliverSimulationEvents();
+    DeliverJobUpdates();
+
+    // Enviar a JS los registros de log acumulados durante el frame
+    Log::Flush();
 }
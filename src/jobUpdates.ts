@@ -0,0 +1,43 @@
+// Notificación de un trabajo en segundo plano enviada desde C++ (Module.onJobUpdate)
+export interface JobUpdate {
+  id: number;
+  type: "progress" | "partial" | "done" | "cancelled" | "failed";
+  progress: number;
+  offset: number;
+  values: Float32Array;
+}
+
+export type JobListener = (update: JobUpdate) => void;
+
+// Listeners por módulo: id del trabajo → listener
+const registries = new WeakMap<object, Map<number, JobListener>>();
+
+// Suscribe un listener a las notificaciones de un trabajo. Module.onJobUpdate tiene
+// un único manejador, instalado aquí la primera vez, que reparte cada notificación
+// por id; así varios componentes pueden seguir sus trabajos sin pisarse. No hay que
+// asignar module.onJobUpdate a mano. El listener se quita solo tras la notificación
+// final (done, cancelled o failed); la función devuelta lo quita antes.
+export function onJobUpdate(module: any, id: number, listener: JobListener): () => void {
+  let listeners = registries.get(module);
+  if (!listeners) {
+    const byId = new Map<number, JobListener>();
+    listeners = byId;
+    registries.set(module, byId);
+    module.onJobUpdate = (update: JobUpdate) => {
+      const target = byId.get(update.id);
+      if (!target) {
+        return; // Nadie sigue este trabajo (p. ej. un cálculo ya sustituido)
+      }
+      if (update.type === "done" || update.type === "cancelled" || update.type === "failed") {
+        byId.delete(update.id);
+      }
+      target(update);
+    };
+  }
+  listeners.set(id, listener);
+  return () => {
+    if (listeners.get(id) === listener) {
+      listeners.delete(id);
+    }
+  };
+}
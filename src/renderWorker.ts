@@ -0,0 +1,200 @@
+// Modo worker: el módulo WebAssembly (física y WebGL) se ejecuta en
+// public/tennis-worker.js sobre un OffscreenCanvas. Desde el hilo principal solo
+// se reenvían la entrada y las llamadas, así que los renders de React no
+// compiten con el bucle de la simulación.
+
+import { LOADER_SCRIPT_URL, SCRIPT_URL, WASM_URL, type LoaderOptions, type StartupTimings } from "./wasmLoader";
+
+const WORKER_URL = "/tennis-worker.js";
+
+// Códigos de tecla de raylib para las teclas que usan los controles
+const RAYLIB_KEYS: Record<string, number> = {
+  ShiftLeft: 340,
+  ShiftRight: 344,
+  ControlLeft: 341,
+  ControlRight: 345,
+  AltLeft: 342,
+  AltRight: 346,
+  Space: 32,
+  Escape: 256,
+  Enter: 257,
+  ArrowRight: 262,
+  ArrowLeft: 263,
+  ArrowDown: 264,
+  ArrowUp: 265,
+};
+
+function raylibKey(code: string): number | undefined {
+  if (code in RAYLIB_KEYS) return RAYLIB_KEYS[code];
+  if (/^Key[A-Z]$/.test(code)) return code.charCodeAt(3); // KEY_A..KEY_Z = 'A'..'Z'
+  if (/^Digit[0-9]$/.test(code)) return code.charCodeAt(5); // KEY_ZERO..KEY_NINE = '0'..'9'
+  return undefined;
+}
+
+// Botones del DOM (0 izquierdo, 1 central, 2 derecho) a los de raylib (0 izquierdo, 1 derecho, 2 central)
+const RAYLIB_MOUSE_BUTTONS = [0, 2, 1];
+
+interface PendingCall {
+  resolve: (value: any) => void;
+  reject: (reason: any) => void;
+}
+
+let workerPromise: Promise<any> | null = null;
+
+export function isWorkerRenderSupported(canvas: HTMLCanvasElement): boolean {
+  return typeof Worker !== "undefined" && typeof canvas.transferControlToOffscreen === "function";
+}
+
+// Reenvía ratón y teclado del canvas visible al worker
+function forwardInput(canvas: HTMLCanvasElement, width: number, height: number, worker: Worker) {
+  const toCanvas = (event: PointerEvent | WheelEvent) => {
+    const rect = canvas.getBoundingClientRect();
+    return {
+      x: ((event.clientX - rect.left) * width) / rect.width,
+      y: ((event.clientY - rect.top) * height) / rect.height,
+    };
+  };
+
+  canvas.addEventListener("pointermove", (event) => {
+    worker.postMessage({ type: "input", kind: "move", ...toCanvas(event) });
+  });
+  canvas.addEventListener("pointerdown", (event) => {
+    canvas.setPointerCapture(event.pointerId); // Seguir el arrastre fuera del canvas
+    worker.postMessage({ type: "input", kind: "move", ...toCanvas(event) });
+    worker.postMessage({ type: "input", kind: "button", button: RAYLIB_MOUSE_BUTTONS[event.button] ?? event.button, down: true });
+  });
+  canvas.addEventListener("pointerup", (event) => {
+    worker.postMessage({ type: "input", kind: "button", button: RAYLIB_MOUSE_BUTTONS[event.button] ?? event.button, down: false });
+  });
+  canvas.addEventListener(
+    "wheel",
+    (event) => {
+      event.preventDefault();
+      // Rueda hacia arriba = positivo, como GetMouseWheelMove()
+      worker.postMessage({ type: "input", kind: "wheel", delta: -Math.sign(event.deltaY) });
+    },
+    { passive: false }
+  );
+
+  const onKey = (down: boolean) => (event: KeyboardEvent) => {
+    const key = raylibKey(event.code);
+    if (key !== undefined) {
+      worker.postMessage({ type: "input", kind: "key", key, down });
+    }
+  };
+  window.addEventListener("keydown", onKey(true));
+  window.addEventListener("keyup", onKey(false));
+
+  // Al perder el foco no llegan los keyup/pointerup: soltar todo
+  window.addEventListener("blur", () => {
+    worker.postMessage({ type: "input", kind: "button", button: 0, down: false });
+    for (const key of [RAYLIB_KEYS.ShiftLeft, RAYLIB_KEYS.ShiftRight]) {
+      worker.postMessage({ type: "input", kind: "key", key, down: false });
+    }
+  });
+
+  new ResizeObserver(() => {
+    const rect = canvas.getBoundingClientRect();
+    worker.postMessage({ type: "resize", cssWidth: rect.width, cssHeight: rect.height });
+  }).observe(canvas);
+}
+
+// Carga el módulo en el worker una sola vez (el canvas solo puede transferirse una vez).
+// Devuelve un objeto con la misma forma que el módulo (module._shootBall(...),
+// module.onJobUpdate = ...), pero las funciones devuelven promesas.
+export function loadTennisWorker(canvas: HTMLCanvasElement, options: LoaderOptions = {}): Promise<any> {
+  if (workerPromise) {
+    return workerPromise;
+  }
+
+  const t0 = performance.now();
+  const width = canvas.width;
+  const height = canvas.height;
+  const rect = canvas.getBoundingClientRect();
+  const offscreen = canvas.transferControlToOffscreen();
+  const worker = new Worker(WORKER_URL);
+
+  const pending = new Map<number, PendingCall>();
+  let nextCallId = 1;
+
+  const call = (name: string, args: unknown[]) =>
+    new Promise<any>((resolve, reject) => {
+      const id = nextCallId++;
+      pending.set(id, { resolve, reject });
+      worker.postMessage({ type: "call", id, name, args });
+    });
+
+  // Las propiedades asignadas (onJobUpdate...) reciben los eventos del worker;
+  // cualquier otra se convierte en una llamada a la función exportada
+  const handlers: Record<string, any> = {
+    FS: { readFile: (path: string, opts?: unknown) => call("FS.readFile", [path, opts]) },
+    ccall: (...args: unknown[]) => call("ccall", args),
+  };
+  const moduleProxy = new Proxy(handlers, {
+    get(target, prop) {
+      if (typeof prop !== "string" || prop === "then") return undefined;
+      if (prop in target) return target[prop];
+      return (...args: unknown[]) => call(prop, args);
+    },
+  });
+
+  workerPromise = new Promise<any>((resolve, reject) => {
+    worker.onmessage = (event: MessageEvent) => {
+      const message = event.data;
+      switch (message.type) {
+        case "ready":
+          resolve(moduleProxy);
+          break;
+        case "result": {
+          const request = pending.get(message.id);
+          pending.delete(message.id);
+          if (message.error !== undefined) request?.reject(new Error(message.error));
+          else request?.resolve(message.value);
+          break;
+        }
+        case "event":
+          if (message.name === "onStartupMetrics") {
+            // Pasar las marcas del reloj del worker al del hilo principal
+            const m = message.payload;
+            const shift = m.timeOrigin - performance.timeOrigin;
+            const timings: StartupTimings = {
+              scriptMs: m.scriptMs,
+              downloadMs: m.downloadMs,
+              compileMs: m.compileMs,
+              instantiateMs: m.instantiateMs,
+              initWindowMs: m.initWindowEnd - m.mainStart,
+              firstFrameMs: m.firstFrameEnd - m.mainStart,
+              totalMs: m.firstFrameEnd + shift - t0,
+            };
+            console.log("[WASM] Tiempos de arranque en worker (ms):", timings);
+            options.onStartupTimings?.(timings);
+          } else if (typeof handlers[message.name] === "function") {
+            handlers[message.name](message.payload);
+          }
+          break;
+        case "error":
+          console.error("[Worker]", message.message);
+          reject(new Error(message.message));
+          break;
+      }
+    };
+    worker.onerror = (event) => reject(new Error(event.message));
+  });
+
+  forwardInput(canvas, width, height, worker);
+  worker.postMessage(
+    {
+      type: "init",
+      canvas: offscreen,
+      loaderUrl: new URL(LOADER_SCRIPT_URL, location.href).href,
+      scriptUrl: new URL(SCRIPT_URL, location.href).href,
+      wasmUrl: new URL(WASM_URL, location.href).href,
+      devicePixelRatio: window.devicePixelRatio,
+      cssWidth: rect.width,
+      cssHeight: rect.height,
+    },
+    [offscreen]
+  );
+
+  return workerPromise;
+}
@@ -0,0 +1,44 @@
+// Lote de eventos de simulación que entrega Module.onSimulationEvents una vez por
+// frame. data contiene count registros de 28 bytes con el formato de SimEvent
+// (src/cpp/SimulationEvents.h): type, source (u32), time, x, y, z, value (f32).
+
+export const SIM_EVENT_BYTES = 28;
+
+export const SIM_EVENT_TYPES = ["bounce", "netHit", "stop", "netCrossed"] as const;
+
+export type SimulationEventType = (typeof SIM_EVENT_TYPES)[number];
+
+export type SimulationEventBatch = {
+  count: number;
+  dropped: number; // Eventos perdidos por cola llena en este frame
+  data: ArrayBuffer;
+};
+
+export type SimulationEvent = {
+  type: SimulationEventType;
+  source: number;
+  time: number; // Segundos de simulación
+  // bounce/netHit: punto de contacto; netCrossed: centro en el cruce; stop: centro
+  position: { x: number; y: number; z: number };
+  // bounce: velocidad de impacto; netHit: altura del contacto; netCrossed: margen sobre la red
+  value: number;
+};
+
+// Decodifica el lote sin copiar el buffer: dos vistas sobre los mismos bytes
+export function decodeSimulationEvents(batch: SimulationEventBatch): SimulationEvent[] {
+  const words = new Uint32Array(batch.data);
+  const floats = new Float32Array(batch.data);
+  const stride = SIM_EVENT_BYTES / 4;
+  const events: SimulationEvent[] = [];
+  for (let i = 0; i < batch.count; i++) {
+    const base = i * stride;
+    events.push({
+      type: SIM_EVENT_TYPES[words[base]],
+      source: words[base + 1],
+      time: floats[base + 2],
+      position: { x: floats[base + 3], y: floats[base + 4], z: floats[base + 5] },
+      value: floats[base + 6],
+    });
+  }
+  return events;
+}
@@ -0,0 +1,103 @@
+// Carga del módulo WebAssembly con instrumentación de arranque
+
+export const SCRIPT_URL = "/cpp/tennis_emulator.js";
+export const WASM_URL = "/cpp/tennis_emulator.wasm";
+// Compilación e instanciación compartidas con el worker de render (public/tennis-wasm.js)
+export const LOADER_SCRIPT_URL = "/tennis-wasm.js";
+
+// Tiempos de arranque en milisegundos
+export interface StartupTimings {
+  scriptMs: number; // Descarga y evaluación del JS generado por Emscripten
+  downloadMs: number; // Descarga del .wasm (solapada con la compilación en streaming)
+  compileMs: number; // Compilación en streaming (incluye la descarga)
+  instantiateMs: number; // Instanciación del módulo compilado
+  initWindowMs: number; // InitWindow() dentro de main()
+  firstFrameMs: number; // Desde el inicio de main() hasta terminar el primer frame
+  totalMs: number; // Desde que se pide el módulo hasta el primer frame
+}
+
+export interface LoaderOptions {
+  onStartupTimings?: (timings: StartupTimings) => void;
+}
+
+// Métricas enviadas desde C++ (Module.onStartupMetrics)
+interface NativeStartupMetrics {
+  mainStart: number;
+  initWindowEnd: number;
+  firstFrameEnd: number;
+}
+
+// Fases medidas por TennisWasm.createModule
+interface InstantiationTimings {
+  compileMs: number;
+  instantiateMs: number;
+}
+
+// Lo que public/tennis-wasm.js deja en window.TennisWasm
+interface TennisWasm {
+  resourceDuration(url: string): number;
+  createModule(moduleArgs: object, wasmUrl: string, timings: InstantiationTimings): Promise<any>;
+}
+
+let modulePromise: Promise<any> | null = null;
+
+function loadScript(src: string): Promise<void> {
+  return new Promise((resolve, reject) => {
+    const script = document.createElement("script");
+    script.src = src;
+    script.async = true;
+    script.onload = () => resolve();
+    script.onerror = () => reject(new Error("Error cargando script WASM"));
+    document.body.appendChild(script);
+  });
+}
+
+// Carga el módulo una sola vez (StrictMode monta los efectos dos veces en desarrollo)
+export function loadTennisModule(
+  canvas: HTMLCanvasElement,
+  options: LoaderOptions = {}
+): Promise<any> {
+  if (modulePromise) {
+    return modulePromise;
+  }
+
+  const t0 = performance.now();
+  let scriptMs = 0;
+  const timings: InstantiationTimings = { compileMs: 0, instantiateMs: 0 };
+
+  modulePromise = Promise.all([loadScript(LOADER_SCRIPT_URL), loadScript(SCRIPT_URL)]).then(() => {
+    scriptMs = performance.now() - t0;
+
+    const tennisWasm: TennisWasm = (window as any).TennisWasm;
+    return tennisWasm.createModule(
+      {
+        canvas: canvas,
+        locateFile: (path: string) => "/cpp/" + path,
+        print: (t: string) => console.log("[WASM]", t),
+        printErr: (t: string) => console.error("[WASM]", t),
+
+        onStartupMetrics: (metrics: NativeStartupMetrics) => {
+          const startupTimings: StartupTimings = {
+            scriptMs,
+            downloadMs: tennisWasm.resourceDuration(WASM_URL),
+            compileMs: timings.compileMs,
+            instantiateMs: timings.instantiateMs,
+            initWindowMs: metrics.initWindowEnd - metrics.mainStart,
+            firstFrameMs: metrics.firstFrameEnd - metrics.mainStart,
+            totalMs: metrics.firstFrameEnd - t0,
+          };
+          console.log("[WASM] Tiempos de arranque (ms):", startupTimings);
+          options.onStartupTimings?.(startupTimings);
+        },
+      },
+      WASM_URL,
+      timings
+    );
+  });
+
+  modulePromise.catch(() => {
+    modulePromise = null;
+  });
+
+  return modulePromise;
+}